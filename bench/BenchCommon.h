@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "ClimbMath.h"
+
+// Helpers shared by ClimbBench (timings) and ClimbTests (behaviour checks).
+namespace Bench {
+
+    template <class F>
+    inline double NsPer(int count, F&& f) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) f(i);
+        auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / count;
+    }
+
+    // Hand moving along a curve; velocity at time t, in the solver's scale, from a ring filled at hz
+    inline Climb::Vec3 CurvePos(double t) {
+        return {static_cast<float>(30.0 * std::sin(t * 2.1)), static_cast<float>(10.0 * t),
+                static_cast<float>(90.0 + 40.0 * std::sin(t * 5.0))};
+    }
+
+    // The SpeedRing this replaced (one hand), kept for comparison
+    class LegacySpeedRing {
+    public:
+        const Climb::Vec3 emptyPoint{123.0f, 0.0f, 0.0f};
+        std::vector<Climb::Vec3> buffer;
+        std::size_t capacity;
+        std::size_t indexCurrent{0};
+        explicit LegacySpeedRing(std::size_t cap) : buffer(cap), capacity(cap) {
+            for (auto& p : buffer) p = emptyPoint;
+        }
+        void Push(Climb::Vec3 p) {
+            buffer[indexCurrent] = p;
+            indexCurrent = (indexCurrent + 1) % capacity;
+        }
+        Climb::Vec3 GetVelocity(std::size_t N) const {
+            Climb::Vec3 startPos = buffer[(indexCurrent - N + capacity) % capacity];
+            Climb::Vec3 endPos = buffer[(indexCurrent - 1 + capacity) % capacity];
+            if ((startPos - emptyPoint).Length() < 0.01f || (endPos - emptyPoint).Length() < 0.01f) return {};
+            return (endPos - startPos) / static_cast<float>(N);
+        }
+    };
+
+}
@@ -0,0 +1,293 @@
+// Headless ClimbSolver benchmark.
+// Usage: ClimbBench [seconds-of-session] [repeats] [--record trace-path]
+// Replays a synthetic 90 Hz hand-over-hand session through the solver and reports ns per frame.
+// --record also writes the session as a FrameTrace, which ClimbReplay can diff against.
+// Behaviour checks live in ClimbTests.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "ClimbSolver.h"
+#include "FrameTrace.h"
+#include "RayFan.h"
+#include "HitCache.h"
+#include "SurfaceHash.h"
+#include "FormClassCache.h"
+#include "HapticQueue.h"
+#include "KinematicsRing.h"
+#include "MotionFilter.h"
+#include "SyntheticClimb.h"
+#include "BenchCommon.h"
+
+namespace {
+    void BenchRings() {
+        const int pushes = 2000000;
+        std::vector<Climb::Vec3> path(4096);
+        for (std::size_t i = 0; i < path.size(); i++) path[i] = Bench::CurvePos(i * 0.011);
+        Bench::LegacySpeedRing old(100);
+        Climb::KinematicsRing ring;
+        Climb::Vec3 sink;
+        double oldNs = Bench::NsPer(pushes, [&](int i) {
+            old.Push(path[i & 4095]);
+            sink += old.GetVelocity(3);
+        });
+        double lsNs = Bench::NsPer(pushes, [&](int i) {
+            ring.Push(path[i & 4095], i * 0.011);
+            sink += ring.VelocityLeastSquares(0.025f);
+        });
+        double sgNs = Bench::NsPer(pushes, [&](int i) {
+            ring.Push(path[i & 4095], i * 0.011);
+            sink += ring.VelocitySavitzkyGolay(0.05f);
+        });
+        std::printf("Hand ring push+velocity  legacy %.2f ns  line fit %.2f ns  Savitzky-Golay %.2f ns  (sink %.1f)\n",
+                    oldNs, lsNs, sgNs, sink.x + sink.y + sink.z);
+    }
+
+    // Offline filter evaluation: one hand hangs still, pulls 40 units fast (0.25 s), hangs, then
+    // pulls 40 units slowly (1 s), with +-0.15 unit tracking noise. The velocity comes from the
+    // kinematics ring like in game. Lag = how late the filtered velocity crosses half the fast
+    // pull's peak; jitter = RMS velocity while hanging (hand units/s).
+    struct FilterScore {
+        float lagMs{0.0f};
+        float jitter{0.0f};
+    };
+
+    float PullPos(double t, double start, double length) {
+        double u = (t - start) / length;
+        u = u < 0.0 ? 0.0 : (u > 1.0 ? 1.0 : u);
+        return static_cast<float>(40.0 * u * u * (3.0 - 2.0 * u));
+    }
+
+    // mode: -1 = unfiltered, otherwise Climb::MotionFilterMode
+    FilterScore EvaluateFilter(int mode, double hz, const ClimbingSettings& settings) {
+        const double fastStart = 1.0, fastLen = 0.25, slowStart = 2.5, slowLen = 1.0, end = 4.5;
+        const Climb::OneEuroFilter::Params euro{settings.fOneEuroMinCutoff, settings.fOneEuroBeta, settings.fOneEuroDCutoff};
+        Climb::KinematicsRing ring;
+        Climb::OneEuroFilter oneEuro;
+        Climb::Vec3 ema;
+        std::uint32_t noise = 12345;
+        double jitterSum = 0.0;
+        int jitterCount = 0;
+        double trueCross = 0.0, filteredCross = -1.0;
+        float lastSpeed = 0.0f;
+        const float halfPeak = static_cast<float>(40.0 * 1.5 / fastLen) * 0.5f;  // Smoothstep peak slope / 2
+        const int frames = static_cast<int>(end * hz);
+        const float dt = static_cast<float>(1.0 / hz);
+        for (int f = 0; f < frames; f++) {
+            const double t = f / hz;
+            noise = noise * 1664525u + 1013904223u;
+            const float n = ((noise >> 8) / 16777216.0f - 0.5f) * 0.3f;
+            const float z = PullPos(t, fastStart, fastLen) + PullPos(t, slowStart, slowLen);
+            ring.Push({n * 0.5f, 35.0f + n, 90.0f - z + n}, t);
+
+            Climb::Vec3 v = ring.VelocityLeastSquares(settings.fVelocityWindow) * Climb::kSolverVelocityScale;
+            if (f == 0) {
+                ema = v;
+                oneEuro.Reset(v);
+            }
+            Climb::Vec3 out = v;
+            if (mode == static_cast<int>(Climb::MotionFilterMode::kExponential)) {
+                const float a = Climb::ExpAlpha(settings.fMotionSmoothing, dt);
+                ema = v * a + ema * (1.0f - a);
+                out = ema;
+            } else if (mode == static_cast<int>(Climb::MotionFilterMode::kOneEuro)) {
+                out = oneEuro.Filter(v, dt, euro);
+            }
+
+            const float speed = -out.z / Climb::kSolverVelocityScale;  // Hand units/s, pulling down = positive
+            const bool hanging = (t > 0.3 && t < fastStart) || (t > fastStart + fastLen + 0.3 && t < slowStart) ||
+                                 t > slowStart + slowLen + 0.3;
+            if (hanging) {
+                jitterSum += static_cast<double>(out.Length() / Climb::kSolverVelocityScale) * (out.Length() / Climb::kSolverVelocityScale);
+                jitterCount++;
+            }
+            // Half-peak crossings, interpolated between frames
+            if (t >= fastStart && filteredCross < 0.0 && speed >= halfPeak) {
+                filteredCross = t - (speed - halfPeak) / (speed - lastSpeed) / hz;
+            }
+            lastSpeed = speed;
+        }
+        // Smoothstep slope 6u(1-u) reaches half its peak at u = (1 - 1/sqrt(2)) / 2
+        trueCross = fastStart + fastLen * (1.0 - std::sqrt(0.5)) * 0.5;
+        FilterScore score;
+        score.lagMs = static_cast<float>((filteredCross - trueCross) * 1000.0);
+        score.jitter = jitterCount ? static_cast<float>(std::sqrt(jitterSum / jitterCount)) : 0.0f;
+        return score;
+    }
+
+    void EvaluateMotionFilters() {
+        const ClimbingSettings settings;
+        for (double hz : {90.0, 144.0}) {
+            auto raw = EvaluateFilter(-1, hz, settings);
+            auto exp = EvaluateFilter(static_cast<int>(Climb::MotionFilterMode::kExponential), hz, settings);
+            auto euro = EvaluateFilter(static_cast<int>(Climb::MotionFilterMode::kOneEuro), hz, settings);
+            std::printf("MotionFilter %3.0f Hz  lag / hang jitter:  unfiltered %5.1f ms %5.2f u/s   exponential %5.1f ms "
+                        "%5.2f u/s   One Euro %5.1f ms %5.2f u/s\n",
+                        hz, raw.lagMs, raw.jitter, exp.lagMs, exp.jitter, euro.lagMs, euro.jitter);
+        }
+    }
+}
+
+
+int main(int argc, char** argv) {
+    Synthetic::SessionParams params;
+    int repeats = 200;
+    const char* recordPath = nullptr;
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--record") && i + 1 < argc) recordPath = argv[++i];
+        else if (positional++ == 0) params.seconds = static_cast<float>(std::atof(argv[i]));
+        else repeats = std::atoi(argv[i]);
+    }
+
+    const auto frames = Synthetic::MakeSession(params);
+    const ClimbingSettings settings;
+
+    Climb::ClimbSolver solver;
+
+    if (recordPath) {
+        Climb::TraceWriter writer;
+        if (!writer.Open(recordPath)) {
+            std::fprintf(stderr, "Failed to open %s\n", recordPath);
+            return 2;
+        }
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            const auto& in = frames[i];
+            Climb::Vec3 relPos[2] = {in.hands[Climb::kLeft].position, in.hands[Climb::kRight].position};
+            writer.Write(in, solver.Step(in, settings), relPos, settings);
+        }
+        writer.Close();
+        solver.Reset();
+    }
+    float checksum = 0.0f;
+    int climbingFrames = 0;
+
+    // Warm-up pass
+    for (const auto& in : frames) solver.Step(in, settings);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        solver.Reset();
+        for (const auto& in : frames) {
+            auto cmd = solver.Step(in, settings);
+            checksum += cmd.velocity.Z();
+            climbingFrames += cmd.setVelocity;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double totalNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    double frameCount = static_cast<double>(frames.size()) * repeats;
+
+    std::printf("ClimbSolver::Step  frames=%.0f  climbing=%.1f%%  %.2f ns/frame  (checksum %.3f)\n", frameCount,
+                100.0 * climbingFrames / frameCount, totalNs / frameCount, checksum);
+
+    // Ray setup for both hands, legacy pair vs. full fan
+    Climb::HandRayPose poses[2];
+    for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+        poses[hand] = {frames[0].hands[hand].position, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {}};
+    }
+    const Climb::ProbeMode modeSets[][2] = {{Climb::ProbeMode::kProbe, Climb::ProbeMode::kProbe},
+                                            {Climb::ProbeMode::kLegacy, Climb::ProbeMode::kLegacy},
+                                            {Climb::ProbeMode::kFan, Climb::ProbeMode::kFan}};
+    const char* modeNames[] = {"probe", "legacy", "fan(9)"};
+    for (int m = 0; m < 3; m++) {
+        Climb::RayBatch batch;
+        const int iterations = 1000000;
+        float sink = 0.0f;
+        auto rayStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            poses[0].translate.z = static_cast<float>(i & 63);
+            Climb::BuildRayBatch(poses, modeSets[m], settings.fRayDist, Climb::kMaxFanRays, batch);
+            sink += batch.to[batch.first[1]][2];
+        }
+        auto rayEnd = std::chrono::steady_clock::now();
+        double rayNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(rayEnd - rayStart).count());
+        std::printf("BuildRayBatch %-7s %2d rays  %.2f ns/batch  (sink %.1f)\n", modeNames[m],
+                    batch.count[0] + batch.count[1], rayNs / iterations, sink);
+    }
+
+    // Hover cache effectiveness on the synthetic motion (reaching hands are not gripping)
+    Climb::HitCoherenceCache<Climb::SurfaceHit> cache;
+    Climb::HitCacheParams cacheParams;
+    for (const auto& in : frames) {
+        for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+            const auto& h = in.hands[hand];
+            if (!cache.Lookup(hand, h.position, {0, 1, 0}, h.gripping, cacheParams) && !h.gripping) {
+                cache.Store(hand, h.position, {0, 1, 0}, h.hit);
+            }
+        }
+    }
+    std::printf("HitCoherenceCache  %.1f%% of hover queries served from cache\n", cache.Stats().HitRatio() * 100.0);
+
+    // Surface hash: a wall at y = 60 sampled by a hand sweeping in front of it
+    Climb::SurfaceHash surfaces;
+    surfaces.Reset(4096);
+    const int sweeps = 200000;
+    auto hashStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < sweeps; i++) {
+        auto tick = static_cast<std::uint32_t>(i);
+        Climb::Vec3 hand(static_cast<float>(i % 400) - 200.0f, 30.0f, static_cast<float>((i / 400) % 300));
+        auto known = surfaces.Query(hand, {0, 1, 0}, settings.fRayDist, tick);
+        if (!known.hit) {
+            Climb::SurfaceSample sample;
+            sample.point = {hand.x, 60.0f, hand.z};
+            sample.normal = {0, -1, 0};
+            sample.climbable = true;
+            surfaces.Insert(sample, tick);
+        }
+    }
+    auto hashEnd = std::chrono::steady_clock::now();
+    double hashNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(hashEnd - hashStart).count());
+    const auto& ss = surfaces.Stats();
+    std::printf("SurfaceHash  %.1f%% answered from memory  %llu evictions  %zu KB  %.2f ns/query\n",
+                100.0 * ss.answered / ss.queries, static_cast<unsigned long long>(ss.evictions),
+                surfaces.MemoryBytes() / 1024, hashNs / sweeps);
+
+    // Form classification: repeat lookups over a working set of 2000 base forms
+    Climb::FormClassCache classes;
+    for (std::uint32_t id = 1; id <= 2000; id++) {
+        classes.Insert(0x00010000u + id * 7u, Climb::SurfaceClass::Pack(true, id % 13 == 0, Climb::Material::kStone));
+    }
+    const int lookups = 5000000;
+    unsigned iceCount = 0;
+    auto classStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        std::uint8_t cls = 0;
+        if (classes.Find(0x00010000u + (1u + static_cast<std::uint32_t>(i) % 2000u) * 7u, cls)) {
+            iceCount += Climb::SurfaceClass::IsIce(cls);
+        }
+    }
+    auto classEnd = std::chrono::steady_clock::now();
+    double classNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(classEnd - classStart).count());
+    std::printf("FormClassCache::Find  %.2f ns/lookup  (%zu forms, %zu slots, ice hits %u)\n", classNs / lookups,
+                classes.Size(), classes.Capacity(), iceCount);
+
+    // Haptics: pulses the solver asks for vs. the VM dispatches FlushHaptics makes for them
+    Climb::ClimbSolver hapticSolver;
+    Climb::HapticQueue haptics;
+    unsigned long long vrikDispatches = 0, gameDispatches = 0;
+    for (std::size_t i = 0; i < frames.size(); i++) {
+        auto cmd = hapticSolver.Step(frames[i], settings);
+        for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+            if (cmd.hands[hand].hoverPulse) haptics.Push(hand, 1, 1000);
+            if (cmd.hands[hand].clickPulse) haptics.Push(hand, 2, 40000);
+        }
+        auto flush = haptics.Flush(i / params.hz);
+        vrikDispatches += flush.Count();
+        gameDispatches += flush.Shared() ? 1 : flush.Count();
+    }
+    const auto& hs = haptics.Stats();
+    const double sessionSeconds = frames.size() / params.hz;
+    // Before: every request was one DispatchStaticCall plus one or two TypeIsValid lookups
+    std::printf("HapticQueue  %.1f requests/s -> %.1f VRIK / %.1f Game dispatches/s  (%.1f type lookups/s removed)\n",
+                hs.requests / sessionSeconds, vrikDispatches / sessionSeconds, gameDispatches / sessionSeconds,
+                hs.requests / sessionSeconds);
+
+    BenchRings();
+    EvaluateMotionFilters();
+    return 0;
+}
@@ -0,0 +1,379 @@
+// Microbenchmarks for the per-frame climbing primitives (Google Benchmark).
+// Everything here is the plugin's own code from the engine-free core; the engine types it touches
+// (NiPoint3, hkVector4, RE::FormType) are replaced by the small stand-ins below.
+//
+//   ClimbMicro --benchmark_out=micro.json --benchmark_out_format=json
+//
+// writes machine-readable results; compare two builds with Google Benchmark's tools/compare.py.
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "ClimbSolver.h"
+#include "ClimberPool.h"
+#include "FormClassCache.h"
+#include "KinematicsRing.h"
+#include "MaterialMatcher.h"
+#include "MotionFilter.h"
+#include "RayFan.h"
+#include "SettingsSchema.h"
+#include "SyntheticClimb.h"
+#include "VelocityPipeline.h"
+
+namespace {
+
+    // ---------------------------------------------------------------------------------------------
+    // Engine stand-ins
+    // ---------------------------------------------------------------------------------------------
+    struct NiPoint3 {
+        float x, y, z;
+    };
+    struct alignas(16) hkVector4 {
+        float quad[4];
+    };
+    // Same enumerator names as RE::FormType (values as in CommonLibSSE)
+    enum class FormType : std::uint8_t {
+        Activator = 24, Container = 28, Door = 29, Light = 31, Misc = 32, Static = 34, MovableStatic = 36,
+        Grass = 37, Tree = 38, Flora = 39, Furniture = 40, Weapon = 41, Ammo = 42, NPC = 43, Reference = 61, ActorCharacter = 62,
+    };
+
+    Climb::Vec3 ToVec3(const NiPoint3& p) { return {p.x, p.y, p.z}; }
+    NiPoint3 Quad2Velo(const hkVector4& v) { return {v.quad[0], v.quad[1], v.quad[2]}; }
+
+    // Minimal INI reader standing in for CSimpleIniA: case-insensitive sections and keys,
+    // ';' and '#' comments, values trimmed.
+    class IniStandIn {
+    public:
+        bool Load(const char* path) {
+            std::FILE* f = std::fopen(path, "rb");
+            if (!f) return false;
+            std::string text;
+            char chunk[4096];
+            for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) > 0;) text.append(chunk, n);
+            std::fclose(f);
+            if (text.starts_with("\xEF\xBB\xBF")) text.erase(0, 3);
+
+            std::string section;
+            std::size_t pos = 0;
+            while (pos < text.size()) {
+                std::size_t eol = text.find('\n', pos);
+                if (eol == std::string::npos) eol = text.size();
+                std::string line = Trim(text.substr(pos, eol - pos));
+                pos = eol + 1;
+                if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+                if (line[0] == '[') {
+                    section = Lower(line.substr(1, line.find(']') - 1));
+                    sections.push_back(section);
+                    continue;
+                }
+                const auto eq = line.find('=');
+                if (eq == std::string::npos) continue;
+                values[section][Lower(Trim(line.substr(0, eq)))] = Trim(line.substr(eq + 1));
+            }
+            return true;
+        }
+
+        const char* GetValue(const std::string& section, const char* key) const {
+            auto s = values.find(section);
+            if (s == values.end()) return nullptr;
+            auto k = s->second.find(Lower(key));
+            return k == s->second.end() ? nullptr : k->second.c_str();
+        }
+
+        std::vector<std::string> sections;
+
+    private:
+        static std::string Trim(const std::string& s) {
+            const auto b = s.find_first_not_of(" \t\r");
+            if (b == std::string::npos) return {};
+            return s.substr(b, s.find_last_not_of(" \t\r") - b + 1);
+        }
+        static std::string Lower(std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+            return s;
+        }
+
+        std::map<std::string, std::map<std::string, std::string>> values;
+    };
+
+    // Base object names and keyword editor IDs as the raycasts meet them
+    const std::vector<std::string>& SurfaceNames() {
+        static const std::vector<std::string> names = {
+            "Nordic Ruins Wall",  "RockCliff04",        "Pine Tree",        "Dwarven Pipe Straight", "Wooden Plank Floor",
+            "Glacier Slab",       "Frozen Waterfall",   "Snow Drift",       "Iron Gate",             "Farmhouse Wall",
+            "MountainCliff Large", "Ice Floe",          "Dirt Cliff",       "Steel Barrel",          "Log Pile",
+            "WRTempleWall01",     "LocTypeDungeon",     "ImperialTowerWall", "Grass Mound",          "CaveGiantPillar",
+        };
+        return names;
+    }
+    const std::vector<std::string>& KeywordIDs() {
+        static const std::vector<std::string> ids = {"LocTypeDwelling", "VendorItemFirewood", "LocTypeDungeon", "ArmorMaterialIron",
+                                                     "MaterialWood", "LocTypeNordicRuin", "MagicSnowTrail", "isSnowObject"};
+        return ids;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // Hand kinematics (SpeedRing replacement)
+    // ---------------------------------------------------------------------------------------------
+    void BM_KinematicsRingPush(benchmark::State& state) {
+        Climb::KinematicsRing ring;
+        double t = 0.0;
+        for (auto _ : state) {
+            ring.Push({static_cast<float>(t), 1.0f, 2.0f}, t);
+            t += 1.0 / 90.0;
+        }
+        benchmark::DoNotOptimize(ring.Latest());
+    }
+    BENCHMARK(BM_KinematicsRingPush);
+
+    void BM_KinematicsRingVelocity(benchmark::State& state) {
+        const auto estimator = static_cast<Climb::VelocityEstimator>(state.range(0));
+        const float window = estimator == Climb::VelocityEstimator::kLeastSquares ? 0.025f : 0.05f;
+        Synthetic::SessionParams params;
+        Climb::KinematicsRing ring;
+        for (int i = 0; i < 64; i++) ring.Push(Synthetic::HandPos(params, 0, i / params.hz), i / params.hz);
+        for (auto _ : state) benchmark::DoNotOptimize(ring.Velocity(estimator, window));
+    }
+    BENCHMARK(BM_KinematicsRingVelocity)->Arg(0)->Arg(1)->ArgName("estimator");
+
+    // ---------------------------------------------------------------------------------------------
+    // Solver math
+    // ---------------------------------------------------------------------------------------------
+    void BM_MotionSmoothingExp(benchmark::State& state) {
+        const ClimbingSettings settings;
+        Climb::Vec3 last{}, v{10.0f, -3.0f, 40.0f};
+        float dt = 1.0f / 90.0f;
+        for (auto _ : state) {
+            const float a = Climb::ExpAlpha(settings.derived.motionAlpha, dt);
+            last = v * a + last * (1.0f - a);
+            v.z = -v.z;
+            benchmark::DoNotOptimize(last);
+        }
+    }
+    BENCHMARK(BM_MotionSmoothingExp);
+
+    void BM_MotionSmoothingOneEuro(benchmark::State& state) {
+        Climb::OneEuroFilter filter;
+        const Climb::OneEuroFilter::Params params;
+        Climb::Vec3 v{10.0f, -3.0f, 40.0f};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(filter.Filter(v, 1.0f / 90.0f, params));
+            v.z = -v.z;
+        }
+    }
+    BENCHMARK(BM_MotionSmoothingOneEuro);
+
+    void BM_GrabBlend(benchmark::State& state) {
+        const ClimbingSettings settings;
+        const Climb::Vec4 entry{0.0f, 0.0f, -600.0f}, target{5.0f, 2.0f, 120.0f};
+        float remaining = settings.fGrabSmoothing;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Climb::GrabBlend(entry, target, remaining, settings.fGrabSmoothing));
+            remaining = remaining > 0.0f ? remaining - 1.0f / 90.0f : settings.fGrabSmoothing;
+        }
+    }
+    BENCHMARK(BM_GrabBlend);
+
+    // hkVector4 -> NiPoint3 -> Vec3, clamp to fMaxVelocity (half the inputs are over the limit)
+    void BM_VelocityClamp(benchmark::State& state) {
+        const ClimbingSettings settings;
+        hkVector4 velocities[2] = {{{300.0f, -50.0f, 900.0f, 0.0f}}, {{1800.0f, 200.0f, 900.0f, 0.0f}}};
+        int i = 0;
+        for (auto _ : state) {
+            const auto v = ToVec3(Quad2Velo(velocities[i++ & 1]));
+            benchmark::DoNotOptimize(Climb::ClampLength(v, settings.fMaxVelocity));
+        }
+    }
+    BENCHMARK(BM_VelocityClamp);
+
+    void BM_AverageNormal(benchmark::State& state) {
+        const Climb::Vec3 normals[2] = {{0.0f, -1.0f, 0.1f}, {0.2f, -0.9f, 0.0f}};
+        const bool holding[3][2] = {{true, true}, {true, false}, {false, true}};
+        Climb::Vec3 out;
+        int i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Climb::AverageNormal(normals, holding[i], out));
+            benchmark::DoNotOptimize(out);
+            i = i == 2 ? 0 : i + 1;
+        }
+    }
+    BENCHMARK(BM_AverageNormal);
+
+    // Whole velocity pipeline on Vec3 (scalar) vs Vec4 (SSE where available)
+    template <class V>
+    void BM_VelocityPipeline(benchmark::State& state) {
+        const auto frames = Synthetic::MakeSession({});
+        const ClimbingSettings settings;
+        Synthetic::VelocityPipeline<V> pipeline;
+        pipeline.Start(V(Climb::Vec3(0.0f, 0.0f, -600.0f)), settings);
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const Climb::Vec3 hands[2] = {frames[i].hands[Climb::kLeft].velocity, frames[i].hands[Climb::kRight].velocity};
+            benchmark::DoNotOptimize(pipeline.Step(hands, frames[i].dt, settings));
+            if (++i == frames.size()) i = 0;
+        }
+    }
+    BENCHMARK_TEMPLATE(BM_VelocityPipeline, Climb::Vec3);
+    BENCHMARK_TEMPLATE(BM_VelocityPipeline, Climb::Vec4);
+
+    void BM_SolverStep(benchmark::State& state) {
+        const auto frames = Synthetic::MakeSession({});
+        const ClimbingSettings settings;
+        Climb::ClimbSolver solver;
+        std::size_t i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(solver.Step(frames[i], settings));
+            if (++i == frames.size()) i = 0;
+        }
+    }
+    BENCHMARK(BM_SolverStep);
+
+    // ---------------------------------------------------------------------------------------------
+    // Surface classification
+    // ---------------------------------------------------------------------------------------------
+    void BM_IsClimbableFormType(benchmark::State& state) {
+        const FormType types[] = {FormType::Static, FormType::Tree, FormType::ActorCharacter, FormType::Misc,
+                                  FormType::Door, FormType::Weapon, FormType::Furniture, FormType::Light};
+        int i = 0;
+        for (auto _ : state) benchmark::DoNotOptimize(Climb::SurfaceClass::IsClimbableFormType(types[i++ & 7]));
+    }
+    BENCHMARK(BM_IsClimbableFormType);
+
+    void BM_IsBlacklistedLayer(benchmark::State& state) {
+        std::uint32_t layer = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Climb::SurfaceClass::IsBlacklistedLayer(layer) ||
+                                     !Climb::SurfaceClass::IsUnownedClimbableLayer(layer));
+            layer = (layer + 7) & 0x7F;
+        }
+    }
+    BENCHMARK(BM_IsBlacklistedLayer);
+
+    // Sound::PredictMaterial without the form lookups: keywords first, then the name
+    void BM_PredictMaterial(benchmark::State& state) {
+        const auto matcher = Climb::MaterialMatcher::Defaults();
+        const auto& names = SurfaceNames();
+        const auto& keywords = KeywordIDs();
+        std::size_t i = 0;
+        for (auto _ : state) {
+            Climb::Material mat = Climb::Material::kStone;
+            auto keywordAt = [&](std::uint32_t k) { return keywords[(i + k) % keywords.size()].c_str(); };
+            matcher.MatchSurface(2, keywordAt, names[i % names.size()].c_str(), mat);
+            benchmark::DoNotOptimize(mat);
+            i++;
+        }
+    }
+    BENCHMARK(BM_PredictMaterial);
+
+    void BM_NameHasIce(benchmark::State& state) {
+        const auto& names = SurfaceNames();
+        std::size_t i = 0;
+        for (auto _ : state) benchmark::DoNotOptimize(Climb::SurfaceClass::NameHasIce(names[i++ % names.size()]));
+    }
+    BENCHMARK(BM_NameHasIce);
+
+    // IsIce / IsWhitelisted / material after the first hit on a form: one cache probe
+    void BM_SurfaceClassCached(benchmark::State& state) {
+        Climb::FormClassCache cache;
+        std::vector<std::uint32_t> ids;
+        for (std::uint32_t n = 0; n < 2000; n++) {
+            ids.push_back(0x00010000 + n * 37);
+            cache.Insert(ids.back(), Climb::SurfaceClass::Pack(true, n % 9 == 0, Climb::Material::kStone));
+        }
+        std::size_t i = 0;
+        for (auto _ : state) {
+            std::uint8_t cls = 0;
+            benchmark::DoNotOptimize(cache.Find(ids[i++ % ids.size()], cls) && Climb::SurfaceClass::IsIce(cls));
+        }
+    }
+    BENCHMARK(BM_SurfaceClassCached);
+
+    // ---------------------------------------------------------------------------------------------
+    // SetVelocity hook
+    // ---------------------------------------------------------------------------------------------
+    // HookSetVelocity's dispatch: look the controller up in the climber pool, then call the original
+    // (through a pointer, like the vtable trampoline) with either the game's velocity or the climb
+    // override. The pool holds the player plus three NPC climbers; the world has ~1000 other
+    // controllers, which is what the hook sees almost every call.
+    struct HookStandIn {
+        Climb::ClimberPool<int> pool;
+        std::vector<std::uintptr_t> npcs;
+        Climb::Vec4 applied;
+
+        HookStandIn() {
+            pool.Bind(Climb::ClimberPool<int>::kPlayerSlot, 0x7FF600001000);
+            for (int n = 0; n < 3; n++) pool.Bind(1 + n, 0x7FF600002000 + n * 0x2A0);
+            pool.command[0].Publish({Climb::Vec4(0.0f, 0.0f, 120.0f), true, 1, 0});
+            for (std::uintptr_t n = 0; n < 1000; n++) npcs.push_back(0x7FF610000000 + n * 0x6F0);
+        }
+    };
+
+    void (*volatile originalSetVelocity)(HookStandIn&, const Climb::Vec4&) = [](HookStandIn& h, const Climb::Vec4& v) {
+        h.applied = v;
+    };
+
+    void Hook(HookStandIn& h, std::uintptr_t controller, const Climb::Vec4& velocity) {
+        const int slot = h.pool.Find(controller);
+        if (slot < 0) return originalSetVelocity(h, velocity);
+        const auto cmd = h.pool.command[slot].Read();
+        originalSetVelocity(h, cmd.active ? cmd.velocity : velocity);
+    }
+
+    void BM_HookNonClimber(benchmark::State& state) {
+        HookStandIn h;
+        const Climb::Vec4 gameVelocity(10.0f, 0.0f, -5.0f);
+        std::size_t i = 0;
+        for (auto _ : state) {
+            Hook(h, h.npcs[i++ % h.npcs.size()], gameVelocity);
+            benchmark::DoNotOptimize(h.applied);
+        }
+    }
+    BENCHMARK(BM_HookNonClimber);
+
+    void BM_HookClimber(benchmark::State& state) {
+        HookStandIn h;
+        const Climb::Vec4 gameVelocity(10.0f, 0.0f, -5.0f);
+        for (auto _ : state) {
+            Hook(h, h.pool.controller[Climb::ClimberPool<int>::kPlayerSlot], gameVelocity);
+            benchmark::DoNotOptimize(h.applied);
+        }
+    }
+    BENCHMARK(BM_HookClimber);
+
+    // ---------------------------------------------------------------------------------------------
+    // Settings
+    // ---------------------------------------------------------------------------------------------
+    // LoadSection for [Climbing] and every [Race_*] section of the shipped INI (file already parsed)
+    void BM_LoadSectionShippedIni(benchmark::State& state) {
+        IniStandIn ini;
+        if (!ini.Load(FREECLIMB_SOURCE_DIR "/Release/FreeClimbVR_Settings.ini")) {
+            state.SkipWithError("Release/FreeClimbVR_Settings.ini not found");
+            return;
+        }
+        std::vector<std::string> raceSections;
+        for (const auto& s : ini.sections) {
+            if (s.starts_with("race_")) raceSections.push_back(s);
+        }
+        int issues = 0;
+        auto report = [&](const Climb::SettingField&, Climb::FieldIssue, const char*) { issues++; };
+        for (auto _ : state) {
+            ClimbingSettings base;
+            Climb::LoadFields(base, [&](const char* key) { return ini.GetValue("climbing", key); }, report);
+            for (const auto& section : raceSections) {
+                ClimbingSettings race = base;
+                Climb::LoadFields(race, [&](const char* key) { return ini.GetValue(section, key); }, report);
+                benchmark::DoNotOptimize(race);
+            }
+            benchmark::DoNotOptimize(base);
+        }
+        state.counters["sections"] = static_cast<double>(1 + raceSections.size());
+        if (issues) state.SkipWithError("the shipped INI has invalid or out-of-range values");
+    }
+    BENCHMARK(BM_LoadSectionShippedIni);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,59 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include "ClimbSolver.h"
+
+// Scripted hand-over-hand climbing session used by the headless benchmarks.
+// Each hand grips, pulls down ~40 units over half a cycle, releases and reaches up again,
+// with the two hands half a cycle apart. A small tremor stands in for tracking jitter.
+namespace Synthetic {
+
+    struct SessionParams {
+        float hz{90.0f};        // Headset refresh rate
+        float seconds{10.0f};
+        float cycle{1.2f};      // Seconds per grab/pull/release cycle
+        float pull{40.0f};      // Pull distance per cycle (game units)
+        float jitter{0.15f};    // Tracking noise amplitude (game units)
+    };
+
+    // Hand position relative to the player at time t (seconds).
+    inline Climb::Vec3 HandPos(const SessionParams& p, int hand, float t) {
+        float phase = std::fmod(t / p.cycle + (hand ? 0.5f : 0.0f), 1.0f);
+        // Pull down during the first half, reach back up during the second.
+        float z = phase < 0.5f ? p.pull * (0.5f - phase) * 2.0f : p.pull * (phase - 0.5f) * 2.0f;
+        float noise = p.jitter * std::sin(t * 97.0f + hand * 1.7f) * std::sin(t * 23.0f);
+        return {hand ? 20.0f : -20.0f, 35.0f + noise, 90.0f + z + noise};
+    }
+
+    inline bool HandGripping(const SessionParams& p, int hand, float t) {
+        float phase = std::fmod(t / p.cycle + (hand ? 0.5f : 0.0f), 1.0f);
+        return phase < 0.5f;
+    }
+
+    // Frame inputs for the whole session; velocities are per-frame deltas like SpeedRing::GetVelocity.
+    inline std::vector<Climb::FrameInput> MakeSession(const SessionParams& p) {
+        std::vector<Climb::FrameInput> frames;
+        const float dt = 1.0f / p.hz;
+        const int count = static_cast<int>(p.seconds * p.hz);
+        frames.reserve(count);
+        for (int i = 0; i < count; i++) {
+            float t = i * dt;
+            Climb::FrameInput in;
+            in.dt = dt;
+            in.stamina = 100.0f;
+            in.hasCharController = true;
+            for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+                auto& h = in.hands[hand];
+                h.tracked = true;
+                h.gripping = HandGripping(p, hand, t);
+                h.position = HandPos(p, hand, t);
+                h.velocity = (HandPos(p, hand, t) - HandPos(p, hand, t - 3 * dt)) / 3.0f;
+                h.hit.hit = true;
+                h.hit.normal = {0.0f, -1.0f, 0.0f};
+            }
+            frames.push_back(in);
+        }
+        return frames;
+    }
+
+}
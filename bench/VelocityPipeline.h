@@ -0,0 +1,55 @@
+#pragma once
+#include "ClimbSolver.h"
+#include "MotionFilter.h"
+
+// The solver's per-frame climb velocity math (hand sum, force multiplier, grab blend, EMA, throw
+// boost, clamp), written once for Climb::Vec3 and Climb::Vec4 so the benchmarks can time the
+// scalar and SIMD forms side by side and check they agree.
+namespace Synthetic {
+
+    inline float GetZ(const Climb::Vec3& v) { return v.z; }
+    inline float GetZ(const Climb::Vec4& v) { return v.Z(); }
+    inline Climb::Vec3 BoostZ(const Climb::Vec3& v, float mult) { return {v.x, v.y, v.z * mult}; }
+    inline Climb::Vec4 BoostZ(const Climb::Vec4& v, float mult) { return v * Climb::Vec4(1.0f, 1.0f, mult); }
+
+    template <class V>
+    struct VelocityPipeline {
+        V entry;
+        V last;
+        float smoothing{0.0f};
+
+        void Start(const V& entryVelo, const ClimbingSettings& settings) {
+            entry = entryVelo;
+            smoothing = settings.fGrabSmoothing;
+            primed = false;
+        }
+
+        V Step(const Climb::Vec3 handVelocity[2], float dt, const ClimbingSettings& settings) {
+            V total;
+            total -= V(handVelocity[Climb::kLeft]);
+            total -= V(handVelocity[Climb::kRight]);
+            total = total * settings.fForceMulti;
+
+            if (smoothing > 0.0f && settings.fGrabSmoothing > 0.0f) {
+                smoothing -= dt;
+                float t = 1.0f - (smoothing / settings.fGrabSmoothing);
+                if (t < 0.0f) t = 0.0f;
+                if (t > 1.0f) t = 1.0f;
+                total = entry + (total - entry) * t;
+            }
+
+            if (!primed) last = total;
+            primed = true;
+            const float a = Climb::ExpAlpha(settings.derived.motionAlpha, dt);
+            total = (total * a) + (last * (1.0f - a));
+            last = total;
+
+            if (GetZ(total) > 0.0f) total = BoostZ(total, settings.fThrowMult);
+            return ClampLength(total, settings.fMaxVelocity);
+        }
+
+    private:
+        bool primed{false};
+    };
+
+}
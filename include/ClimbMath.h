@@ -0,0 +1,35 @@
+#pragma once
+#include <cmath>
+
+namespace Climb {
+
+    // Engine-free 3-vector covering the subset of RE::NiPoint3 the climbing code uses.
+    // Lets the solver build and run without CommonLibSSE (see ClimbSolver.h).
+    struct Vec3 {
+        float x{0.0f};
+        float y{0.0f};
+        float z{0.0f};
+
+        constexpr Vec3() = default;
+        constexpr Vec3(float a_x, float a_y, float a_z) : x(a_x), y(a_y), z(a_z) {}
+
+        constexpr Vec3 operator+(const Vec3& o) const { return {x + o.x, y + o.y, z + o.z}; }
+        constexpr Vec3 operator-(const Vec3& o) const { return {x - o.x, y - o.y, z - o.z}; }
+        constexpr Vec3 operator*(float s) const { return {x * s, y * s, z * s}; }
+        constexpr Vec3 operator/(float s) const { return {x / s, y / s, z / s}; }
+
+        constexpr Vec3& operator+=(const Vec3& o) { x += o.x; y += o.y; z += o.z; return *this; }
+        constexpr Vec3& operator-=(const Vec3& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
+
+        constexpr float SqrLength() const { return x * x + y * y + z * z; }
+        float Length() const { return std::sqrt(SqrLength()); }
+        float GetDistance(const Vec3& o) const { return (*this - o).Length(); }
+    };
+
+    // v scaled down to maxLength if longer (direction kept)
+    inline Vec3 ClampLength(const Vec3& v, float maxLength) {
+        const float len = v.Length();
+        return len > maxLength ? v * (maxLength / len) : v;
+    }
+
+}
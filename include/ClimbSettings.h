@@ -0,0 +1,51 @@
+#pragma once
+
+// Plain climbing parameters. Kept free of SimpleIni/CommonLibSSE so the headless
+// solver and its tools can share them with the plugin (Settings::ClimbingSettings).
+// Keys, defaults and ranges are listed in SettingsSchema.h; keep the two in step.
+struct ClimbingSettings {
+    float fStaminaCostMove{0.30f};
+    float fStaminaCostIdle{0.02f};
+    float fStaminaOneHandCostMult{2.0f};
+    float fStaminaMovementThreshold{10.0f};
+
+    float fForceMulti{1.1f};
+    float fRayDist{65.0f};
+    float fMaxArmLength{120.0f};
+    float fGrabSmoothing{0.2f};
+
+    float fThrowMult{1.5f};
+    float fThrowReleaseThreshold{180.0f};
+    float fThrowTimeWindow{0.6f}; // Time in seconds to "remember" peak velocity
+    float fMaxFlingVelocity{800.0f};
+
+    float fMaxVelocity{1500.0f};
+    float fMotionSmoothing{0.4f}; // [0.0 - 1.0]. Lower = Less Jitter/More Lag. Per 90 Hz frame
+    int iMotionFilter{0};         // 0 = exponential (fMotionSmoothing), 1 = One Euro
+    float fOneEuroMinCutoff{1.0f}; // Hz. One Euro cutoff while the velocity is steady
+    float fOneEuroBeta{5.0f};     // One Euro cutoff increase with velocity change
+    float fOneEuroDCutoff{1.0f};  // Hz. One Euro smoothing of the velocity change rate
+    int iVelocityEstimator{0};    // Hand velocity: 0 = line fit, 1 = Savitzky-Golay (quadratic fit)
+    float fVelocityWindow{0.025f}; // Seconds of hand samples the velocity is estimated from
+    int iRayFanSize{7};           // Rays per hand while a grab is imminent [5 - 9]
+    bool bAdaptiveRays{true};     // false = always cast the legacy forward/down pair
+    float fGrabLookAhead{40.0f};  // ms of predicted hand travel a reaching hand's sweep ray covers (0 = off)
+    float fHoverCacheMove{2.0f};  // Hand travel (units) before a hover raycast is redone. 0 = always cast
+    float fHoverCacheAngle{6.0f}; // Hand rotation (degrees) before a hover raycast is redone
+    int iHoverCacheFrames{8};     // Redo hover raycasts at least every N frames
+    int iSurfaceCacheSize{4096};  // Remembered surface samples per cell (0 = off, max 65536)
+    int iMaxClimbVoices{4};         // Climb sounds playing at once (both hands) [1 - 8]
+    float fClimbSoundCooldown{0.12f}; // Minimum seconds between grab sounds of one hand
+    bool bEnableHaptics{true};
+    float fHapticStrength{1.0f};  // Vibration intensity multiplier (0 = off)
+    bool bUseVRIKHaptics{false};  // Prefer VRIK.VrikHapticPulse over Game.ShakeController
+    bool bEnableStamina{true};
+    bool bEnableWholeMod{true};
+    bool bDisableFallDamage{true}; // New option
+
+    // Precomputed from the fields above once per load (Climb::UpdateDerived), not per frame
+    struct Derived {
+        float maxArmLengthSq{120.0f * 120.0f}; // Stretch check without a sqrt
+        float motionAlpha{0.4f};               // fMotionSmoothing clamped to [0.01, 1]
+    } derived;
+};
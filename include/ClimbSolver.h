@@ -0,0 +1,142 @@
+#pragma once
+#include <cstdint>
+#include "ClimbMath.h"
+#include "ClimbVec4.h"
+#include "ClimbSettings.h"
+#include "MotionFilter.h"
+
+// Headless climbing solver.
+// Owns every piece of per-climb state that used to live in function statics inside
+// ZacOnFrame::ClimbMain. It never talks to the engine: the frame hook gathers hand poses,
+// grip state and raycast results into a FrameInput, and applies the returned FrameCommand.
+namespace Climb {
+
+    constexpr int kLeft = 0;
+    constexpr int kRight = 1;
+
+    constexpr std::uint32_t kPlayerRefID = 0x14;
+
+    // Grab impact smoothing: blend from the entry velocity to the climb velocity as the
+    // remaining smoothing time runs from `duration` down to 0.
+    inline Vec4 GrabBlend(const Vec4& entry, const Vec4& target, float remaining, float duration) {
+        float t = 1.0f - (remaining / duration); // 0.0 to 1.0
+        if (t < 0.0f) t = 0.0f;
+        if (t > 1.0f) t = 1.0f;
+        return entry + (target - entry) * t;
+    }
+
+    // Unit average of the wall normals of the holding hands. False if no hand holds (or they cancel out).
+    inline bool AverageNormal(const Vec3 normals[2], const bool holding[2], Vec3& out) {
+        Vec3 n(0, 0, 0);
+        int c = 0;
+        if (holding[kLeft]) { n += normals[kLeft]; c++; }
+        if (holding[kRight]) { n += normals[kRight]; c++; }
+        if (c == 0) return false;
+        n = n / static_cast<float>(c);
+        const float len = n.Length();
+        if (len <= 0.001f) return false;
+        out = n / len;
+        return true;
+    }
+
+    // Raycast result as seen by the solver (filled from ClimbHitData).
+    struct SurfaceHit {
+        bool hit{false};
+        Vec3 normal;
+        std::uint32_t refrFormID{0}; // 0 = static world geometry (no reference)
+        bool isIce{false};           // Only evaluated while gripping a reference
+    };
+
+    struct HandInput {
+        bool tracked{false};         // Hand node available this frame
+        bool gripping{false};
+        bool hasClimbingTool{false}; // Only evaluated when the hit surface is ice
+        Vec3 position;               // Hand node world translate (on a grip press frame: at the press time)
+        Vec3 velocity;               // Hand velocity relative to the player (speed buffer)
+        SurfaceHit hit;              // Only read when WantsProbe() was true for this hand
+    };
+
+    struct FrameInput {
+        HandInput hands[2];
+        float dt{0.011f};
+        float stamina{-1.0f};        // < 0 = unknown / not read
+        bool hasCharController{false};
+        Vec4 charVelocity;           // Controller velocity, read while a climb may start
+    };
+
+    // Per-hand side effects the caller dispatches (sound, haptics, logging).
+    struct HandEvents {
+        bool grabbed{false};
+        bool clickPulse{false};
+        bool hoverPulse{false};
+        bool iceSlip{false};
+    };
+
+    struct FrameCommand {
+        bool setVelocity{false};     // Override the proxy controller velocity with `velocity`
+        Vec4 velocity;
+
+        bool startedClimb{false};    // First climbing frame (cancel jump animation)
+        bool resetFallState{false};  // Zero fallStartHeight/fallTime on the controller
+        bool resetFallAnim{false};   // Zero the "FallTime" graph variable
+        bool staminaDepleted{false};
+        float staminaCost{0.0f};     // Stamina to damage this frame
+
+        bool launch{false};          // Hand the climb momentum back to the controller
+        Vec4 launchVelocity;
+
+        HandEvents hands[2];
+    };
+
+    class ClimbSolver {
+    public:
+        // Whether the hand needs a raycast this frame (not holding and not waiting for release).
+        bool WantsProbe(int hand, bool gripping) const;
+
+        bool IsHolding(int hand) const { return hands[hand].isHolding; }
+        bool IsClimbing() const { return wasClimbing; }
+        // Nothing held, no release pending and the post-release window over: a Reset() here
+        // changes nothing the player can feel.
+        bool IsIdle() const {
+            return !wasClimbing && postReleaseTimer <= 0.0f && !hands[0].isHolding && !hands[1].isHolding &&
+                   !hands[0].mustRelease && !hands[1].mustRelease;
+        }
+
+        FrameCommand Step(const FrameInput& in, const ClimbingSettings& settings);
+        void Reset();
+
+    private:
+        struct HandState {
+            bool isHolding{false};
+            bool mustRelease{false};
+            Vec3 grabPoint;          // Captured grab position
+            Vec3 wallNormal;         // Captured wall normal
+            int hapticCool{0};
+            int hoverSkip{0};
+        };
+
+        bool CheckHand(int hand, const HandInput& in, const ClimbingSettings& settings, HandEvents& events);
+        void UpdateRetainedNormal();
+
+        HandState hands[2];
+
+        // Smoothing State
+        bool wasClimbing{false};
+        float smoothingTimer{0.0f};
+        Vec4 entryVelo;
+        Vec4 lastAppliedVelo;        // To preserve momentum on release
+        Vec4 lastFrameVelo;          // Motion smoothing history
+        OneEuroFilter motionFilter;  // iMotionFilter = 1
+        float postReleaseTimer{0.0f};
+        Vec3 retainedWallNormal;     // Wall normal at moment of release
+
+        // Throw Window Tracker
+        Vec4 peakThrowVelo;
+        float peakThrowTimer{0.0f};
+
+        // Last velocity command (kept while a frame does not update it)
+        bool lastSetVelocity{false};
+        Vec4 lastVelocity;
+    };
+
+}
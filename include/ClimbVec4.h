@@ -0,0 +1,85 @@
+#pragma once
+#include <cmath>
+#include "ClimbMath.h"
+
+#if !defined(FREECLIMB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+    #define FREECLIMB_SSE 1
+    #include <emmintrin.h>
+#endif
+
+// 16-byte aligned xyz vector for the climb velocity pipeline. On x86 it is one SSE register laid
+// out like hkVector4 (w = 0), so the solver's velocity goes to and from Havok without unpacking;
+// elsewhere (or with FREECLIMB_NO_SIMD) it falls back to four floats.
+// Every operation keeps Vec3's evaluation order, so results match the scalar code bit for bit
+// (Length sums x, y, z left to right like Vec3::SqrLength).
+namespace Climb {
+
+    struct alignas(16) Vec4 {
+#ifdef FREECLIMB_SSE
+        __m128 v;
+
+        Vec4() : v(_mm_setzero_ps()) {}
+        Vec4(float x, float y, float z) : v(_mm_set_ps(0.0f, z, y, x)) {}
+        explicit Vec4(const Vec3& p) : v(_mm_set_ps(0.0f, p.z, p.y, p.x)) {}
+        explicit Vec4(__m128 quad) : v(quad) {}  // w must already be 0
+
+        // hkVector4 quad with w cleared
+        static Vec4 FromQuad(__m128 quad) {
+            const __m128 w = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+            return Vec4(_mm_and_ps(quad, w));
+        }
+        __m128 Quad() const { return v; }
+
+        float X() const { return _mm_cvtss_f32(v); }
+        float Y() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))); }
+        float Z() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))); }
+
+        Vec4 operator+(const Vec4& o) const { return Vec4(_mm_add_ps(v, o.v)); }
+        Vec4 operator-(const Vec4& o) const { return Vec4(_mm_sub_ps(v, o.v)); }
+        Vec4 operator*(const Vec4& o) const { return Vec4(_mm_mul_ps(v, o.v)); }  // Per component
+        Vec4 operator*(float s) const { return Vec4(_mm_mul_ps(v, _mm_set1_ps(s))); }
+
+        float SqrLength() const {
+            const __m128 sq = _mm_mul_ps(v, v);
+            const __m128 xy = _mm_add_ss(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1)));
+            return _mm_cvtss_f32(_mm_add_ss(xy, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2))));
+        }
+#else
+        float x{0.0f};
+        float y{0.0f};
+        float z{0.0f};
+        float w{0.0f};
+
+        Vec4() = default;
+        Vec4(float a_x, float a_y, float a_z) : x(a_x), y(a_y), z(a_z) {}
+        explicit Vec4(const Vec3& p) : x(p.x), y(p.y), z(p.z) {}
+
+        float X() const { return x; }
+        float Y() const { return y; }
+        float Z() const { return z; }
+
+        Vec4 operator+(const Vec4& o) const { return {x + o.x, y + o.y, z + o.z}; }
+        Vec4 operator-(const Vec4& o) const { return {x - o.x, y - o.y, z - o.z}; }
+        Vec4 operator*(const Vec4& o) const { return {x * o.x, y * o.y, z * o.z}; }
+        Vec4 operator*(float s) const { return {x * s, y * s, z * s}; }
+
+        float SqrLength() const { return x * x + y * y + z * z; }
+#endif
+
+        Vec4& operator+=(const Vec4& o) { return *this = *this + o; }
+        Vec4& operator-=(const Vec4& o) { return *this = *this - o; }
+
+        float Length() const { return std::sqrt(SqrLength()); }
+        Vec4 WithZ(float z) const { return {X(), Y(), z}; }
+        Vec3 ToVec3() const { return {X(), Y(), Z()}; }
+    };
+
+    static_assert(sizeof(Vec4) == 16 && alignof(Vec4) == 16, "Vec4 must match hkVector4");
+
+    // v scaled down to maxLength if longer (direction kept)
+    inline Vec4 ClampLength(const Vec4& v, float maxLength) {
+        const float len = v.Length();
+        return len > maxLength ? v * (maxLength / len) : v;
+    }
+
+}
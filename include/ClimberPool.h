@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "ClimbSolver.h"
+#include "ClimbVec4.h"
+#include "KinematicsRing.h"
+#include "VelocityCommand.h"
+
+// Climb state for every actor that can climb, and the controller -> actor lookup HookSetVelocity
+// does on each call.
+// The hook runs for every proxy-controlled character in the world (dragons included), so the
+// common case is a controller that is not climbing; it costs one probe into a small flat table
+// before the call is passed on. Actors that can climb get a slot in ClimberPool, whose per-slot
+// state is laid out struct-of-arrays: the few fields the hook reads sit together, apart from
+// the solver and pose histories only the frame touches. The player always has slot 0; the
+// other slots are sized for NPC climbers, which nothing registers yet.
+namespace Climb {
+
+    // Controller address -> climber slot. Open addressing; key and slot are packed into one
+    // 64-bit word so a lookup reads both atomically. One writer (the frame thread), lock-free
+    // readers on any thread. Erased keys leave tombstones, which the writer sweeps out by
+    // rebuilding into the second table and switching to it; a reader whose table was rebuilt
+    // under it (two switches during one probe) sees the generation move and looks again.
+    class ControllerMap {
+    public:
+        static constexpr std::uint32_t kCapacity = 64;  // Power of two; at most ClimberPool::kMaxClimbers live
+        static constexpr std::uint32_t kMask = kCapacity - 1;
+
+        // Slot of the controller, or -1
+        int Find(std::uintptr_t controller) const {
+            for (;;) {
+                const auto gen = generation.load(std::memory_order_acquire);
+                const int slot = Probe(tables[gen & 1], controller);
+                if (generation.load(std::memory_order_acquire) == gen) return slot;
+            }
+        }
+
+        // Writer only. False for an unusable address (null, odd or above 48 bits) or a full table.
+        bool Insert(std::uintptr_t controller, int slot);
+        void Erase(std::uintptr_t controller);
+        void Clear();
+
+        std::uint32_t Tombstones() const { return tombstones; }
+
+    private:
+        static constexpr std::uint64_t kEmpty = 0;
+        static constexpr std::uint64_t kTombstone = 1;  // Never a key: controllers are aligned
+        static constexpr int kSlotShift = 48;
+        static constexpr std::uint64_t kKeyMask = (std::uint64_t{1} << kSlotShift) - 1;
+
+        static std::uint32_t Home(std::uintptr_t controller) {
+            return static_cast<std::uint32_t>(((controller >> 4) * 0x9E3779B97F4A7C15ull) >> 58) & kMask;
+        }
+        static int Probe(const std::atomic<std::uint64_t> (&table)[kCapacity], std::uintptr_t controller) {
+            for (std::uint32_t i = Home(controller), n = 0; n < kCapacity; i = (i + 1) & kMask, n++) {
+                const auto e = table[i].load(std::memory_order_acquire);
+                if (e == kEmpty) return -1;
+                if ((e & kKeyMask) == controller) return static_cast<int>(e >> kSlotShift);
+            }
+            return -1;
+        }
+        void Rebuild();
+
+        std::atomic<std::uint64_t> tables[2][kCapacity]{};
+        std::atomic<std::uint32_t> generation{0};  // tables[generation & 1] is live
+        std::uint32_t live{0};
+        std::uint32_t tombstones{0};
+    };
+
+    // Actor is RE::Actor in the plugin (any type works; the pool only stores the pointer).
+    template <class Actor>
+    class ClimberPool {
+    public:
+        static constexpr int kMaxClimbers = 16;
+        static constexpr int kPlayerSlot = 0;
+
+        // Frame thread. Unbinds the slot and starts its climb state over.
+        void Remove(int slot) {
+            Bind(slot, 0);
+            Reset(slot);
+        }
+
+        // Frame thread. Point the slot at the actor's current controller (0 = none: 3D unloaded).
+        // A changed controller drops any velocity override still aimed at the old one.
+        void Bind(int slot, std::uintptr_t a_controller) {
+            if (controller[slot] == a_controller) return;
+            if (controller[slot]) map.Erase(controller[slot]);
+            command[slot].Clear();
+            controller[slot] = 0;
+            if (a_controller && map.Insert(a_controller, slot)) controller[slot] = a_controller;
+        }
+
+        // Any thread: -1 for controllers of actors that are not in the pool
+        int Find(std::uintptr_t a_controller) const { return map.Find(a_controller); }
+
+        const ControllerMap& Map() const { return map; }
+
+        // Hot: what HookSetVelocity reads and writes
+        VelocityCommandSlot command[kMaxClimbers];  // Written by the frame, read by the hook
+        std::int64_t lastJumpFrame[kMaxClimbers]{};
+        std::int64_t lastOngroundFrame[kMaxClimbers]{};
+        bool inMidAir[kMaxClimbers]{};
+        Actor* actor[kMaxClimbers]{};
+
+        // Cold: the frame's climb step
+        ClimbSolver solver[kMaxClimbers];
+        KinematicsRing handRing[kMaxClimbers][2];  // Hand positions relative to the actor
+        KinematicsRing bodyRing[kMaxClimbers];     // Actor position at the same times
+        std::int64_t anchoredPress[kMaxClimbers][2]{};
+        std::uintptr_t controller[kMaxClimbers]{};
+
+    private:
+        void Reset(int slot) {
+            command[slot].Clear();
+            lastJumpFrame[slot] = 0;
+            lastOngroundFrame[slot] = 0;
+            inMidAir[slot] = false;
+            solver[slot].Reset();
+            handRing[slot][kLeft].Clear();
+            handRing[slot][kRight].Clear();
+            bodyRing[slot].Clear();
+            anchoredPress[slot][kLeft] = 0;
+            anchoredPress[slot][kRight] = 0;
+        }
+
+        ControllerMap map;
+    };
+
+}
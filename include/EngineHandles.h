@@ -0,0 +1,43 @@
+#pragma once
+#include <RE/Skyrim.h>
+#include <cstdint>
+
+// Engine pointers the climb loop needs every frame, resolved once and kept until they go stale.
+// The skeleton hand nodes ("NPC L Hand [LHnd]" by name), the VR node data and its hand nodes
+// are re-resolved only when the player's 3D root changes; the cell's hkpWorld only when the
+// player's cell changes; everything on Invalidate() (CleanBeforeLoad). Each group has a
+// generation counter, bumped only when one of its pointers changes, so caches built on top of
+// it can tell when to drop their contents.
+class EngineHandles {
+public:
+    // Pointer compares against the cached root and cell; lookups happen only on a change
+    void Refresh(RE::PlayerCharacter* player);
+    void Invalidate();
+
+    bool HasNodes() const { return vrData != nullptr; }
+    RE::VR_NODE_DATA* VRData() const { return vrData; }
+    RE::NiNode* VRHand(int hand) const { return vrHand[hand]; }          // Controller-driven (vrData->NPCLHnd/NPCRHnd)
+    RE::NiAVObject* SkeletonHand(int hand) const { return skeletonHand[hand]; }  // In the player's 3D
+
+    // nullptr during cell transitions: no raycasts then
+    RE::TESObjectCELL* Cell() const { return cell; }
+    RE::hkpWorld* World() const { return world; }
+
+    std::uint32_t NodeGeneration() const { return nodeGeneration; }
+    std::uint32_t CellGeneration() const { return cellGeneration; }
+
+private:
+    void ResolveNodes(RE::PlayerCharacter* player);
+    void ResolveWorld(RE::TESObjectCELL* currentCell);
+
+    RE::NiPointer<RE::NiAVObject> root;  // Held so a reloaded 3D can't reuse the same address
+    RE::VR_NODE_DATA* vrData{nullptr};
+    RE::NiNode* vrHand[2]{};
+    RE::NiAVObject* skeletonHand[2]{};
+    RE::TESObjectCELL* cell{nullptr};
+    RE::hkpWorld* world{nullptr};
+    bool cellResolved{false};
+
+    std::uint32_t nodeGeneration{0};
+    std::uint32_t cellGeneration{0};
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+// Chrome trace-event export (open the file in ui.perfetto.dev or chrome://tracing).
+// Every thread that records gets its own preallocated ring on its first event, so recording is a
+// few stores and one release; nothing allocates or locks per event. A background thread drains
+// the rings into the JSON file. When a ring is full the event is dropped (and counted) rather
+// than stalling the frame. Spans are "complete" events (begin + duration), so an event lost to a
+// full ring never leaves an unmatched begin behind.
+// The CLIMB_TRACE_* macros compile to nothing unless FREECLIMB_PROFILE is defined.
+namespace Climb {
+
+    struct TraceEvent {
+        const char* name;      // String literal: only the pointer is stored
+        std::uint64_t tsNs;    // Since Start()
+        std::uint64_t durNs;
+        std::uint32_t arg;
+        char phase;            // 'X' span, 'i' instant
+    };
+
+    class EventTracer {
+    public:
+        static constexpr int kMaxThreads = 16;
+        static constexpr std::uint32_t kRingEvents = 8192;  // Per thread, power of two
+
+        static EventTracer& Get();
+        ~EventTracer() { Stop(); }
+
+        // Opens the file and starts the flusher. False if the file can't be created.
+        bool Start(const char* path, std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100));
+        // Writes what is buffered and closes the file
+        void Stop();
+        bool Enabled() const { return enabled.load(std::memory_order_acquire); }
+
+        void Span(const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end,
+                  std::uint32_t arg = 0);
+        void Instant(const char* name, std::uint32_t arg = 0);
+
+        std::uint64_t Written() const { return written.load(std::memory_order_relaxed); }
+        std::uint64_t Dropped() const;
+
+    private:
+        struct ThreadRing {
+            TraceEvent events[kRingEvents];
+            std::atomic<std::uint64_t> head{0};  // Owning thread
+            std::atomic<std::uint64_t> tail{0};  // Flusher
+            std::atomic<std::uint64_t> dropped{0};
+            std::uint32_t tid{0};
+        };
+
+        void Push(const TraceEvent& ev);
+        ThreadRing* RegisterThread();
+        std::uint64_t SinceStart(std::chrono::steady_clock::time_point t) const;
+        void FlushLoop(std::stop_token stop, std::chrono::milliseconds interval);
+        void Drain();
+
+        std::atomic<bool> enabled{false};
+        std::chrono::steady_clock::time_point origin;
+
+        std::mutex registerLock;
+        std::atomic<ThreadRing*> rings[kMaxThreads]{};
+        std::atomic<int> ringCount{0};
+        std::atomic<std::uint64_t> unregistered{0};  // Events from threads beyond kMaxThreads
+
+        std::mutex fileLock;  // Flusher vs. Stop's final drain
+        std::FILE* file{nullptr};
+        bool firstEvent{true};
+        std::atomic<std::uint64_t> written{0};
+        std::jthread flusher;
+    };
+
+    class ScopedTraceSpan {
+    public:
+        explicit ScopedTraceSpan(const char* name, std::uint32_t arg = 0) : name(name), arg(arg) {
+            if (EventTracer::Get().Enabled()) begin = std::chrono::steady_clock::now();
+        }
+        ~ScopedTraceSpan() {
+            if (begin != std::chrono::steady_clock::time_point{}) EventTracer::Get().Span(name, begin, std::chrono::steady_clock::now(), arg);
+        }
+        ScopedTraceSpan(const ScopedTraceSpan&) = delete;
+        ScopedTraceSpan& operator=(const ScopedTraceSpan&) = delete;
+
+    private:
+        const char* name;
+        std::uint32_t arg;
+        std::chrono::steady_clock::time_point begin{};
+    };
+}
+
+#define CLIMB_TRACE_CONCAT2(a, b) a##b
+#define CLIMB_TRACE_CONCAT(a, b) CLIMB_TRACE_CONCAT2(a, b)
+#ifdef FREECLIMB_PROFILE
+    // Span over the rest of the enclosing scope
+    #define CLIMB_TRACE_SPAN(name, ...) ::Climb::ScopedTraceSpan CLIMB_TRACE_CONCAT(climbTraceSpan, __LINE__)(name __VA_OPT__(,) __VA_ARGS__)
+    #define CLIMB_TRACE_INSTANT(name, ...) \
+        do { if (::Climb::EventTracer::Get().Enabled()) ::Climb::EventTracer::Get().Instant(name __VA_OPT__(,) __VA_ARGS__); } while (0)
+#else
+    #define CLIMB_TRACE_SPAN(name, ...) ((void)0)
+    #define CLIMB_TRACE_INSTANT(name, ...) ((void)0)
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Per-base-form surface classification.
+// The raycast whitelist, the ice check and material detection all used to fetch the base
+// object and scan its name on every hit. Their verdicts only depend on the base form, so they
+// are computed once per form and packed into one byte in a flat open-addressed table.
+namespace Climb {
+
+    enum class Material : std::uint8_t { kStone, kWood, kSnow, kMetal, kDirt, kCount };
+
+    namespace SurfaceClass {
+        constexpr std::uint8_t kWhitelisted = 1 << 0; // Form type may be climbed
+        constexpr std::uint8_t kIce = 1 << 1;         // Ice/Glacier/Frozen: needs a climbing tool
+        constexpr int kMaterialShift = 2;
+        constexpr std::uint8_t kMaterialMask = 0x7 << kMaterialShift;
+
+        constexpr std::uint8_t Pack(bool whitelisted, bool ice, Material material) {
+            return static_cast<std::uint8_t>((whitelisted ? kWhitelisted : 0) | (ice ? kIce : 0) |
+                                             (static_cast<std::uint8_t>(material) << kMaterialShift));
+        }
+        constexpr bool IsWhitelisted(std::uint8_t c) { return c & kWhitelisted; }
+        constexpr bool IsIce(std::uint8_t c) { return c & kIce; }
+        constexpr Material GetMaterial(std::uint8_t c) {
+            return static_cast<Material>((c & kMaterialMask) >> kMaterialShift);
+        }
+
+        // The rules the packed bits are computed from. FormType is RE::FormType in the plugin
+        // (any enum with the same enumerator names works, which lets the benchmarks run headless).
+        template <class FormType>
+        constexpr bool IsClimbableFormType(FormType t) {
+            return t == FormType::Static || t == FormType::MovableStatic || t == FormType::Tree || t == FormType::Flora ||
+                   t == FormType::Furniture || t == FormType::Door || t == FormType::Activator || t == FormType::Container;
+        }
+
+        // Base object name marks ice (needs a climbing tool)
+        constexpr bool NameHasIce(std::string_view name) {
+            return name.find("Ice") != std::string_view::npos || name.find("Glacier") != std::string_view::npos ||
+                   name.find("Frozen") != std::string_view::npos;
+        }
+
+        // Collision layers never grabbed:
+        // 5=Weapon, 6=Projectile, 8=Biped, 32=CharController
+        // 56 = Custom Physics Layer detected in User Log (Pseudo Physics Weapon)
+        // Also blocking 57, 58 just in case.
+        constexpr bool IsBlacklistedLayer(std::uint32_t layer) {
+            return layer == 5 || layer == 6 || layer == 8 || layer == 32 || layer >= 56;
+        }
+
+        // Hits without a reference only count on these layers (static world, terrain)
+        constexpr bool IsUnownedClimbableLayer(std::uint32_t layer) {
+            return layer == 1 || layer == 2 || layer == 3 || layer == 13;
+        }
+    }
+
+    class FormClassCache {
+    public:
+        explicit FormClassCache(std::size_t initialCapacity = 1024);
+
+        // One probe in the common case, never allocates. FormID 0 is never stored.
+        bool Find(std::uint32_t formID, std::uint8_t& out) const {
+            std::size_t idx = IndexOf(formID);
+            while (keys[idx] != 0) {
+                if (keys[idx] == formID) {
+                    out = values[idx];
+                    return true;
+                }
+                idx = (idx + 1) & mask;
+            }
+            return false;
+        }
+
+        void Insert(std::uint32_t formID, std::uint8_t cls);
+        void Clear();
+
+        std::size_t Size() const { return count; }
+        std::size_t Capacity() const { return keys.size(); }
+
+    private:
+        std::size_t IndexOf(std::uint32_t formID) const {
+            return static_cast<std::size_t>((formID * 0x9E3779B1u) >> 8) & mask;
+        }
+        void Grow();
+
+        std::vector<std::uint32_t> keys;
+        std::vector<std::uint8_t> values;
+        std::size_t mask{0};
+        std::size_t count{0};
+    };
+
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "ClimbSolver.h"
+
+// Binary frame trace of the climbing pipeline.
+// A trace is a 32-byte header followed by fixed-size little-endian records, so a reader can
+// memory-map the file and index frames directly. Settings records are written whenever the
+// active ClimbingSettings change, so a replay always runs with what the game was using. A reset
+// record marks a point where the live solver started over (recording opened, game loaded); the
+// replay starts a fresh solver there too, so one trace can span several sessions.
+namespace Climb {
+
+    constexpr char kTraceMagic[8] = {'F', 'C', 'V', 'R', 'T', 'R', 'C', '1'};
+    constexpr std::uint32_t kTraceVersion = 2;  // 2: reset records (version 1 files still read)
+
+    struct TraceHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint32_t recordSize;
+        std::uint32_t settingsSize;
+        std::uint64_t reserved;
+    };
+    static_assert(sizeof(TraceHeader) == 32);
+
+    enum TraceHandFlags : std::uint8_t {
+        kTraceTracked = 1 << 0,
+        kTraceGripping = 1 << 1,
+        kTraceClimbingTool = 1 << 2,
+        kTraceHit = 1 << 3,
+        kTraceIce = 1 << 4,
+    };
+
+    enum TraceFrameFlags : std::uint32_t {
+        kTraceHasCharController = 1 << 0,
+        kTraceSetVelocity = 1 << 1,
+        kTraceLaunch = 1 << 2,
+        kTraceStartedClimb = 1 << 3,
+    };
+
+    struct TraceHand {
+        float relPos[3];   // Speed-buffer sample (hand - player position)
+        float pos[3];
+        float velocity[3];
+        float normal[3];
+        std::uint32_t refrFormID;
+        std::uint8_t flags;
+        std::uint8_t pad[3];
+    };
+    static_assert(sizeof(TraceHand) == 56);
+
+    struct TraceFrame {
+        float dt;
+        float stamina;
+        float charVelocity[3];
+        std::uint32_t flags;
+        TraceHand hands[2];
+        float outVelocity[3];     // Velocity handed to HookSetVelocity
+        float launchVelocity[3];
+    };
+    static_assert(sizeof(TraceFrame) == 160);
+
+    enum class TraceKind : std::uint32_t { kFrame = 0, kSettings = 1, kReset = 2 };
+
+    enum class TraceResetReason : std::uint32_t {
+        kOpened = 0,  // Recording started (the live solver is reset with it)
+        kLoad = 1,    // CleanBeforeLoad reset the live solver
+    };
+
+    struct TraceRecord {
+        TraceKind kind;
+        std::uint32_t frame;
+        union {
+            TraceFrame frameData;
+            unsigned char settingsData[sizeof(TraceFrame)]; // memcpy of ClimbingSettings
+            TraceResetReason resetReason;
+        };
+    };
+    static_assert(sizeof(TraceRecord) == 168);
+    static_assert(sizeof(ClimbingSettings) <= sizeof(TraceFrame));
+    static_assert(std::is_trivially_copyable_v<ClimbingSettings>);
+
+    TraceFrame EncodeFrame(const FrameInput& in, const FrameCommand& cmd, const Vec3 relPos[2]);
+    FrameInput DecodeInput(const TraceFrame& f);
+    ClimbingSettings DecodeSettings(const TraceRecord& rec);
+
+    // Buffered writer used on the frame thread; records are flushed in blocks.
+    class TraceWriter {
+    public:
+        ~TraceWriter() { Close(); }
+
+        bool Open(const char* path);
+        void Close();
+        void Flush();
+        bool IsOpen() const { return file != nullptr; }
+
+        void Write(const FrameInput& in, const FrameCommand& cmd, const Vec3 relPos[2], const ClimbingSettings& settings);
+        // The live solver was reset: frames after this replay on a fresh one. Open() writes kOpened.
+        void Reset(TraceResetReason reason);
+
+    private:
+        void Push(const TraceRecord& rec);
+
+        std::FILE* file{nullptr};
+        std::vector<TraceRecord> buffer;
+        std::uint32_t frameIndex{0};
+        bool hasSettings{false};
+        ClimbingSettings lastSettings;
+    };
+
+    // Read-only memory-mapped view of a trace file.
+    class TraceReader {
+    public:
+        TraceReader() = default;
+        TraceReader(const TraceReader&) = delete;
+        TraceReader& operator=(const TraceReader&) = delete;
+        ~TraceReader() { Close(); }
+
+        bool Open(const char* path);
+        void Close();
+
+        std::size_t Count() const { return count; }
+        const TraceRecord& operator[](std::size_t i) const { return records[i]; }
+
+    private:
+        const TraceRecord* records{nullptr};
+        std::size_t count{0};
+        void* mapping{nullptr};
+        std::size_t mappedSize{0};
+#ifdef _WIN32
+        void* fileHandle{nullptr};
+        void* mapHandle{nullptr};
+#endif
+    };
+
+    struct ReplayStats {
+        std::size_t frames{0};
+        std::size_t resets{0};
+        std::size_t mismatches{0};
+        float maxDiff{0.0f};
+        std::size_t firstMismatch{0};
+    };
+
+    // Feeds every recorded frame back through a ClimbSolver with the recorded settings (a fresh
+    // solver at each reset record) and diffs the velocity commands against the recording.
+    // onMismatch(record, command) is called for each frame off by more than tolerance.
+    template <class OnMismatch>
+    ReplayStats Replay(const TraceReader& trace, float tolerance, OnMismatch&& onMismatch);
+    inline ReplayStats Replay(const TraceReader& trace, float tolerance) {
+        return Replay(trace, tolerance, [](const TraceRecord&, const FrameCommand&) {});
+    }
+
+    namespace detail {
+        inline float MaxAbsDiff(const Vec4& a, const float (&b)[3]) {
+            return std::fmax(std::fabs(a.X() - b[0]), std::fmax(std::fabs(a.Y() - b[1]), std::fabs(a.Z() - b[2])));
+        }
+    }
+
+    template <class OnMismatch>
+    ReplayStats Replay(const TraceReader& trace, float tolerance, OnMismatch&& onMismatch) {
+        ReplayStats stats;
+        ClimbSolver solver;
+        ClimbingSettings settings;
+
+        for (std::size_t i = 0; i < trace.Count(); i++) {
+            const auto& rec = trace[i];
+            if (rec.kind == TraceKind::kSettings) {
+                settings = DecodeSettings(rec);
+                continue;
+            }
+            if (rec.kind == TraceKind::kReset) {
+                solver.Reset();
+                stats.resets++;
+                continue;
+            }
+            if (rec.kind != TraceKind::kFrame) continue;
+
+            const auto& f = rec.frameData;
+            auto cmd = solver.Step(DecodeInput(f), settings);
+            stats.frames++;
+
+            const bool recSet = f.flags & kTraceSetVelocity;
+            const bool recLaunch = f.flags & kTraceLaunch;
+            float diff = 0.0f;
+            if (cmd.setVelocity) diff = detail::MaxAbsDiff(cmd.velocity, f.outVelocity);
+            if (cmd.launch) diff = std::fmax(diff, detail::MaxAbsDiff(cmd.launchVelocity, f.launchVelocity));
+            if (diff > stats.maxDiff) stats.maxDiff = diff;
+            if (cmd.setVelocity != recSet || cmd.launch != recLaunch || diff > tolerance) {
+                if (stats.mismatches == 0) stats.firstMismatch = rec.frame;
+                stats.mismatches++;
+                onMismatch(rec, cmd);
+            }
+        }
+        return stats;
+    }
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+// Edge-triggered grip input.
+// Grip button events are decoded to a hand through a device table (the VR runtimes disagree
+// on which device is which hand) and applied as press/release edges. The state lives in a
+// few atomics, so the event sink writes it and the frame reads it without a lock, and a
+// release is visible on the very next frame instead of after a timeout.
+namespace Climb {
+
+    // Raw button event, as far as grip handling is concerned
+    struct GripEvent {
+        int device{0};
+        std::uint32_t idCode{0};
+        float value{0.0f};  // > 0 while held; 0 on the release event
+
+        bool Pressed() const { return value > 0.0f; }
+    };
+
+    class GripDecoder {
+    public:
+        static constexpr int kMaxDevices = 16;
+
+        GripDecoder() { SetDefaults(); }
+
+        // Devices 1/6 = left, 2/5 = right, grip button ID 2 (IDs 33/34 repeat it and are ignored)
+        void SetDefaults();
+        void ClearDevices();
+        void SetDevice(int device, int hand);  // hand: 0 left, 1 right, -1 ignore
+        // Comma-separated device numbers ("1, 6"); false if any entry was unusable
+        bool SetDeviceList(std::string_view list, int hand);
+        void SetGripButton(std::uint32_t idCode) { gripID = idCode; }
+
+        // Hand the event belongs to, or -1 if it is not a grip event
+        int Decode(const GripEvent& ev) const {
+            if (ev.idCode != gripID || ev.device < 0 || ev.device >= kMaxDevices) return -1;
+            return hands[ev.device];
+        }
+
+    private:
+        std::int8_t hands[kMaxDevices];
+        std::uint32_t gripID{2};
+    };
+
+    // One hand. Written by the input event sink, read by the frame.
+    class GripChannel {
+    public:
+        // now = monotonic nanoseconds. Repeated events in the same state are ignored.
+        void Apply(bool pressed, std::int64_t now) {
+            if (pressed == down.load(std::memory_order_relaxed)) return;
+            if (pressed) {
+                pressedAt.store(now, std::memory_order_relaxed);
+                presses.fetch_add(1, std::memory_order_release);
+            }
+            down.store(pressed, std::memory_order_release);
+        }
+
+        bool IsDown() const { return down.load(std::memory_order_acquire); }
+
+        // Held now, or pressed since the last poll (a tap shorter than a frame still grabs once).
+        // seenPresses belongs to the reader.
+        bool Poll(std::uint32_t& seenPresses) const {
+            const auto p = presses.load(std::memory_order_acquire);
+            const bool tapped = p != seenPresses;
+            seenPresses = p;
+            return IsDown() || tapped;
+        }
+
+        std::int64_t PressedAt() const { return pressedAt.load(std::memory_order_relaxed); }
+
+        // Treat the grip as released (its release event may never come: menu, load)
+        void Reset() {
+            down.store(false, std::memory_order_relaxed);
+            pressedAt.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<bool> down{false};
+        std::atomic<std::uint32_t> presses{0};
+        std::atomic<std::int64_t> pressedAt{0};
+    };
+
+}
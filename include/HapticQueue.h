@@ -0,0 +1,70 @@
+#pragma once
+
+// Per-hand haptic pulse queue.
+// Pulses requested during a frame are held until Flush(), which is meant to run once per frame
+// and returns what to send to the Papyrus VM; the Game backend sends both hands in one
+// Game.ShakeController call when their lengths match. The solver issues at most one pulse per
+// hand per frame, so a second request for the same hand simply replaces the first.
+namespace Climb {
+
+    struct HapticPulse {
+        int intensity{0};  // VRIK scale (1 = weakest). Game.ShakeController uses intensity / 100
+        int lengthUs{0};   // Microseconds
+    };
+
+    struct HapticFlush {
+        bool ready[2]{};
+        HapticPulse pulse[2];
+
+        int Count() const { return (ready[0] ? 1 : 0) + (ready[1] ? 1 : 0); }
+        // Both hands fit in one Game.ShakeController(left, right, duration) call
+        bool Shared() const { return ready[0] && ready[1] && pulse[0].lengthUs == pulse[1].lengthUs; }
+    };
+
+    struct HapticStats {
+        unsigned long long requests{0};    // vibrateController calls (one VM dispatch each before)
+        unsigned long long dispatches{0};  // DispatchStaticCall calls made by the backend
+        unsigned long long shared{0};      // Of those, one call for both hands
+        double seconds{0.0};
+    };
+
+    class HapticQueue {
+    public:
+        void Push(int hand, int intensity, int lengthUs) {
+            stats.requests++;
+            hasPending[hand] = true;
+            pending[hand] = {intensity, lengthUs};
+        }
+
+        // now = seconds on any monotonic clock
+        HapticFlush Flush(double now) {
+            HapticFlush out;
+            if (lastFlush >= 0.0) stats.seconds += now - lastFlush;
+            lastFlush = now;
+
+            for (int hand = 0; hand < 2; hand++) {
+                out.ready[hand] = hasPending[hand];
+                out.pulse[hand] = pending[hand];
+                hasPending[hand] = false;
+            }
+            return out;
+        }
+
+        // The backend reports each VM dispatch it made for a flush
+        void CountDispatch(bool bothHands) {
+            stats.dispatches++;
+            if (bothHands) stats.shared++;
+        }
+
+        void Reset() { *this = HapticQueue(); }
+        const HapticStats& Stats() const { return stats; }
+        void ResetStats() { stats = HapticStats(); }
+
+    private:
+        HapticPulse pending[2];
+        bool hasPending[2]{};
+        double lastFlush{-1.0};
+        HapticStats stats;
+    };
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include "ClimbMath.h"
+
+// Temporal-coherence cache for hover raycasts.
+// While a hand is not gripping, its raycast only drives hover haptics, and a hand that barely
+// moved since the last cast almost always sees the same surface. The cache keeps the last
+// result per hand with the pose it was cast from, and answers the next query from memory until
+// the hand moved or turned past the thresholds, the entry got too old, or the grip is pressed.
+namespace Climb {
+
+    struct HitCacheParams {
+        float maxMove{2.0f};        // Game units of hand travel before a re-cast (0 = cache off)
+        float minCosAngle{0.995f};  // cos of the hand rotation change allowed (~5.7 degrees)
+        int revalidateFrames{8};    // Re-cast at least this often even when still
+    };
+
+    struct HitCacheStats {
+        std::uint64_t hits{0};
+        std::uint64_t misses{0};
+
+        double HitRatio() const {
+            auto total = hits + misses;
+            return total ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+
+    template <class Hit>
+    class HitCoherenceCache {
+    public:
+        // Cached result for the hand, or nullptr when a real raycast is needed.
+        const Hit* Lookup(int hand, const Vec3& pos, const Vec3& forward, bool gripping, const HitCacheParams& params) {
+            auto& e = entries[hand];
+            bool usable = e.valid && !gripping && params.maxMove > 0.0f && e.age < params.revalidateFrames &&
+                          (pos - e.pos).SqrLength() <= params.maxMove * params.maxMove &&
+                          Dot(forward, e.forward) >= params.minCosAngle;
+            if (!usable) {
+                // A grip press always revalidates, and the grab result must not be reused for hover
+                if (gripping) e.valid = false;
+                stats.misses++;
+                return nullptr;
+            }
+            e.age++;
+            stats.hits++;
+            return &e.hit;
+        }
+
+        // `hit` is handed back for several frames, so it must not own engine pointers (see Remembered)
+        void Store(int hand, const Vec3& pos, const Vec3& forward, const Hit& hit) {
+            auto& e = entries[hand];
+            e.valid = true;
+            e.age = 0;
+            e.pos = pos;
+            e.forward = forward;
+            e.hit = hit;
+        }
+
+        void Invalidate(int hand) { entries[hand].valid = false; }
+        void Invalidate() {
+            entries[0].valid = false;
+            entries[1].valid = false;
+        }
+
+        const HitCacheStats& Stats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+    private:
+        static float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+        struct Entry {
+            bool valid{false};
+            int age{0};
+            Vec3 pos;      // Hand position the ray was cast from
+            Vec3 forward;  // Hand forward axis the ray was cast along
+            Hit hit;
+        };
+
+        Entry entries[2];
+        HitCacheStats stats;
+    };
+
+}
@@ -2,6 +2,7 @@
 #include "RE/Skyrim.h"
 #include <chrono>
 #include <atomic>
+#include "GripState.h"
 
 class InputManager : public RE::BSTEventSink<RE::InputEvent*> {
 public:
@@ -10,18 +11,24 @@ public:
     void Register();
     
     // Status Accessors
+    // Grip state is edge-triggered: true from the press event until the release event
+    // (or for one poll after a press that was already released again)
     bool IsLeftGripPressed();
     bool IsRightGripPressed();
+    // Monotonic nanoseconds of the last press event of a hand
+    std::int64_t GripPressedAt(bool isLeft) const;
+    // Release both grips and forget pending taps (CleanBeforeLoad, pausing menus)
+    void ResetGrips();
     bool IsSneaking(); 
 
 protected:
     RE::BSEventNotifyControl ProcessEvent(RE::InputEvent* const* a_event, RE::BSTEventSource<RE::InputEvent*>* a_source) override;
 
 private:
-    std::chrono::steady_clock::time_point _lastLeftPress;
-    std::chrono::steady_clock::time_point _lastRightPress;
     std::chrono::steady_clock::time_point _lastSneakPress;
 
-    std::atomic<bool> _leftGrip{ false };
-    std::atomic<bool> _rightGrip{ false };
+    Climb::GripChannel _leftGrip;
+    Climb::GripChannel _rightGrip;
+    std::uint32_t _leftSeenPresses{ 0 };  // Frame side only
+    std::uint32_t _rightSeenPresses{ 0 };
 };
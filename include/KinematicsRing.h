@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include "ClimbMath.h"
+
+// Timestamped hand position history.
+// Positions and their sample times are kept structure-of-arrays in a power-of-two ring; a
+// bitmask marks which slots hold real samples. Velocity is estimated in units per second
+// from the samples inside a time window, so it no longer depends on the headset refresh rate.
+namespace Climb {
+
+    // ClimbSolver's hand velocity is in the old SpeedRing::GetVelocity(3) scale: two frame
+    // steps divided by three, as measured at 90 Hz, which fForceMulti and friends were tuned
+    // on. Units/second times this gives that scale at 90 Hz, and keeps it at any other rate.
+    constexpr float kSolverVelocityScale = 2.0f / (3.0f * 90.0f);
+
+    enum class VelocityEstimator : int { kLeastSquares = 0, kSavitzkyGolay = 1 };
+
+    class KinematicsRing {
+    public:
+        static constexpr std::uint32_t kCapacity = 64;  // Power of two; also the validity mask width
+        static constexpr std::uint32_t kMask = kCapacity - 1;
+
+        void Push(const Vec3& p, double time) {
+            const std::uint32_t i = head & kMask;
+            x[i] = p.x;
+            y[i] = p.y;
+            z[i] = p.z;
+            t[i] = time;
+            valid |= std::uint64_t(1) << i;
+            head++;
+        }
+
+        void Clear() {
+            valid = 0;
+            head = 0;
+        }
+
+        bool Empty() const { return valid == 0; }
+        std::uint32_t Count() const;
+
+        // Most recently pushed sample (zero if empty)
+        Vec3 Latest() const;
+        double LatestTime() const;
+
+        // Position at `time`, interpolated between the samples either side of it.
+        // False if time is newer than the newest sample or older than the history.
+        bool PositionAt(double time, Vec3& out) const;
+
+        // Slope of a straight-line fit to the samples no older than window seconds (units/s).
+        // Zero with fewer than two samples.
+        Vec3 VelocityLeastSquares(float window) const;
+        // Derivative at the newest sample of a quadratic fit over the window (Savitzky-Golay,
+        // generalised to uneven timestamps). Falls back to the line fit with fewer than four samples.
+        Vec3 VelocitySavitzkyGolay(float window) const;
+
+        Vec3 Velocity(VelocityEstimator estimator, float window) const {
+            return estimator == VelocityEstimator::kSavitzkyGolay ? VelocitySavitzkyGolay(window)
+                                                                  : VelocityLeastSquares(window);
+        }
+
+    private:
+        // Indices of valid samples within window of the newest, newest first
+        std::uint32_t Gather(float window, std::uint32_t out[kCapacity]) const;
+
+        float x[kCapacity]{};
+        float y[kCapacity]{};
+        float z[kCapacity]{};
+        double t[kCapacity]{};
+        std::uint64_t valid{0};
+        std::uint32_t head{0};  // Total pushes; slot = head & kMask
+    };
+
+    // Where the hand was at `time` (e.g. a grip press), given where it is now: current minus the
+    // travel recorded since. Hand samples are relative to the player, so the player's own position
+    // history (`body`, sampled at the same times) adds the body's motion. Returns `current` if
+    // time is more than maxAge seconds before the newest sample or not covered by both histories.
+    Vec3 PositionAtTime(const Vec3& current, const KinematicsRing& hand, const KinematicsRing& body, double time,
+                        double maxAge);
+
+}
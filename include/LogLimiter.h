@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+// Per-call-site log rate limiting. A message that fires every frame (ice slips, stamina
+// depletion) is logged at most once per interval; the next line that gets through reports how
+// many were suppressed in between. Lock-free, so any thread may log through it.
+namespace Climb {
+
+    class LogRateLimiter {
+    public:
+        // True if the message should be logged now. `repeats` = messages suppressed since the last one logged.
+        bool Allow(std::int64_t nowNs, std::int64_t intervalNs, std::uint32_t& repeats) {
+            auto next = nextAllowed.load(std::memory_order_relaxed);
+            if (nowNs < next || !nextAllowed.compare_exchange_strong(next, nowNs + intervalNs, std::memory_order_relaxed)) {
+                suppressed.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            repeats = suppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        static std::int64_t NowNs() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    private:
+        std::atomic<std::int64_t> nextAllowed{std::numeric_limits<std::int64_t>::min()};
+        std::atomic<std::uint32_t> suppressed{0};
+    };
+}
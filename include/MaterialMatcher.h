@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FormClassCache.h"
+
+// Multi-pattern surface material matcher.
+// All name patterns (e.g. "Wood", "Plank", "Dwarven") are compiled at load time into one
+// Aho-Corasick automaton over a compressed alphabet, so classifying a name is a single pass
+// over its bytes no matter how many patterns the INI lists. When several materials match,
+// the one with the lowest rank wins (Wood, Snow, Metal, Dirt, Stone - the legacy order).
+namespace Climb {
+
+    class MaterialMatcher {
+    public:
+        // Patterns are case-sensitive, matching the original name checks.
+        void AddPattern(std::string_view pattern, Material material);
+        // Comma-separated list, surrounding spaces trimmed ("Wood, Tree, Log").
+        void AddPatternList(std::string_view list, Material material);
+        void Clear();
+        void Build();
+
+        // Highest-priority material whose pattern occurs in text; false if none does.
+        bool Match(std::string_view text, Material& out) const;
+
+        // Sound::PredictMaterial's order: keyword editor IDs first, the first one that matches
+        // decides (whatever the name says); then the name. keywordAt(i) may return nullptr.
+        template <class KeywordAt>
+        bool MatchSurface(std::uint32_t keywordCount, KeywordAt&& keywordAt, const char* name, Material& out) const {
+            for (std::uint32_t i = 0; i < keywordCount; i++) {
+                const char* id = keywordAt(i);
+                if (id && Match(id, out)) return true;
+            }
+            return name && Match(name, out);
+        }
+
+        std::size_t PatternCount() const { return patterns.size(); }
+
+        // The built-in table, identical to the old hardcoded name checks.
+        static const char* DefaultPatterns(Material material);
+        static const char* MaterialName(Material material);
+        static MaterialMatcher Defaults();
+
+    private:
+        static int Rank(Material m);
+
+        struct Pattern {
+            std::string text;
+            Material material;
+        };
+        std::vector<Pattern> patterns;
+
+        // Built automaton
+        std::uint8_t byteClass[256]{};
+        int classCount{1};
+        std::vector<std::uint32_t> next;  // node * classCount + class (INI lists can exceed 64K nodes)
+        std::vector<std::int8_t> best;    // Lowest-rank material reachable at node, -1 = none
+        bool built{false};
+    };
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "ClimbMath.h"
+
+// Climb velocity filters.
+// fMotionSmoothing was tuned as a per-frame blend factor at 90 Hz; ExpAlpha converts it to the
+// equivalent factor for any frame time, so the filter's time constant no longer depends on the
+// refresh rate. OneEuroFilter is the adaptive alternative: a low-pass whose cutoff rises with how
+// fast the signal changes, so it smooths hard while hanging still and barely lags a fast pull
+// (Casiez et al., "1 Euro Filter", CHI 2012).
+namespace Climb {
+
+    enum class MotionFilterMode : int { kExponential = 0, kOneEuro = 1 };
+
+    constexpr float kMotionReferenceHz = 90.0f;
+
+    // Per-frame blend factor for dt, equal to alphaAt90 when dt = 1/90 s
+    float ExpAlpha(float alphaAt90, float dt);
+
+    class OneEuroFilter {
+    public:
+        struct Params {
+            float minCutoff{1.0f};  // Hz. Cutoff at rest: lower = less jitter while hanging
+            float beta{5.0f};       // Cutoff increase per unit/s of signal change: higher = less lag
+            float dCutoff{1.0f};    // Hz. Smoothing of the change-rate estimate
+        };
+
+        void Reset(const Vec3& value) {
+            x = value;
+            dx = {};
+            primed = true;
+        }
+        void Clear() { primed = false; }
+
+        Vec3 Filter(const Vec3& value, float dt, const Params& params);
+
+    private:
+        Vec3 x;
+        Vec3 dx;
+        bool primed{false};
+    };
+
+}
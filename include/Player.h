@@ -1,94 +1,51 @@
 #include "Utils.h"
 #include "Settings.h"
+#include "ClimbSolver.h"
+#include "HitCache.h"
+#include "KinematicsRing.h"
+#include "ClimberPool.h"
+#include "EngineHandles.h"
+#include <chrono>
 
 using namespace SKSE;
 
 
-class SpeedRing {
+class PlayerState {
 public:
-    const RE::NiPoint3 emptyPoint = RE::NiPoint3(123.0f, 0.0f, 0.0f);
-
-    std::vector<RE::NiPoint3> bufferL;
-    std::vector<RE::NiPoint3> bufferR;
-    std::size_t capacity;  // how many latest frames are stored
-    std::size_t indexCurrentL;
-    std::size_t indexCurrentR;
-    SpeedRing(std::size_t cap) : bufferL(cap), bufferR(cap), capacity(cap), indexCurrentR(0), indexCurrentL(0) {}
-
-    void Clear() {
-        for (std::size_t i = 0; i < capacity; i++) {
-            bufferL[i] = emptyPoint;
-            bufferR[i] = emptyPoint;
-        }
-    }
-
-    void Push(RE::NiPoint3 p, bool isLeft) {
-        if (isLeft) {
-            bufferL[indexCurrentL] = p;
-            indexCurrentL = (indexCurrentL + 1) % capacity;
-        } else {
-            bufferR[indexCurrentR] = p;
-            indexCurrentR = (indexCurrentR + 1) % capacity;
-        }
-    }
-
-    RE::NiPoint3 GetVelocity(std::size_t N, bool isLeft) const {
-        if (N == 0 || N > capacity) {
-            log::error("N is 0 or larger than capacity");
-            return RE::NiPoint3(0.0f, 0.0f, 0.0f);
-        }
-
-        std::size_t currentIdx = isLeft ? indexCurrentL : indexCurrentR;
-        const std::vector<RE::NiPoint3>& buffer = isLeft ? bufferL : bufferR;
-
-        // Get the start and end positions
-        RE::NiPoint3 startPos = buffer[(currentIdx - N + capacity) % capacity];
-        RE::NiPoint3 endPos = buffer[(currentIdx - 1 + capacity) % capacity];
-
-        auto diff1 = startPos - emptyPoint;
-        auto diff2 = endPos - emptyPoint;
-        if (diff1.Length() < 0.01f || diff2.Length() < 0.01f) {
-            // log::error("startPos or endPos is empty"); 
-            return RE::NiPoint3(0.0f, 0.0f, 0.0f);
-        }
+    using Climbers = Climb::ClimberPool<RE::Actor>;
+    static constexpr int kSlot = Climbers::kPlayerSlot;
 
-        // Calculate velocities
-        RE::NiPoint3 velocityBottom = (endPos - startPos) / static_cast<float>(N);
+    // Every climbing actor's state. Static so HookSetVelocity (called for every character
+    // controller) can look its controller up without going through GetSingleton().
+    static inline Climbers climbers;
 
-        // Return the velocity
-        return velocityBottom;
-    }
-};
-
-class PlayerState {
-public:
     RE::Actor* player;
-    SpeedRing speedBuf;
+    // The player's slot in `climbers`
+    Climb::KinematicsRing (&handRing)[2] = climbers.handRing[kSlot]; // Timestamped hand positions relative to the player (left, right)
+    Climb::KinematicsRing& bodyRing = climbers.bodyRing[kSlot];      // Player position at the same times, to rewind hands in world space
+    std::int64_t (&anchoredPress)[2] = climbers.anchoredPress[kSlot]; // Grip press (InputManager timestamp) last used for a grab anchor
+    Climb::ClimbSolver& solver = climbers.solver[kSlot];              // Grab/hold/throw state driven by ClimbMain
+    Climb::RayFanPlanner rayPlanner; // Adaptive ray count per hand
+    Climb::HitCoherenceCache<ClimbHitData> hoverCache; // Reuses hover raycasts while the hand is still
+    Climb::SurfaceHash surfaceHash;                     // Surfaces seen in the current cell
+    std::uint32_t surfaceCellGen{0};                    // handles.CellGeneration() surfaceHash belongs to
+    EngineHandles handles;                              // Hand nodes, VR node data, hkpWorld
 
-    bool setVelocity;
-    RE::hkVector4 velocity;
-    
     // Climbing State
     float accumulatedStamCost = 0.0f;
-    bool isInMidAir = false; 
     bool shouldCheckKnock = false; 
-    
-    int64_t lastOngroundFrame = 0;
-    int64_t lastJumpFrame = 0;
 
     PlayerState()
-        : player(nullptr),
-          setVelocity(false),
-          speedBuf(SpeedRing(100)) {}
+        : player(nullptr) {}
 
     void Clear() { 
-        setVelocity = false;
-        velocity = RE::NiPoint3();
-        isInMidAir = false;
         shouldCheckKnock = false;
-        lastOngroundFrame = 0;
-        lastJumpFrame = 0;
-        speedBuf.Clear();
+        climbers.Remove(kSlot); // Also unbinds the controller until the next ClimbMain
+        rayPlanner.Reset();
+        hoverCache.Invalidate();
+        surfaceHash.Clear();
+        handles.Invalidate();
+        surfaceCellGen = handles.CellGeneration();
     }
 
     static PlayerState& GetSingleton() {
@@ -105,12 +62,19 @@ public:
                 log::error("Fail to cast player to Actor");
             }
             singleton.player = playerActor;
+            climbers.actor[kSlot] = playerActor;
         }
         return singleton;
     }
 
-    void SetVelocity(float x, float y, float z) {
-        velocity = RE::hkVector4(x, y, z, 0.0f);
+    // Hand this frame's climb velocity to HookSetVelocity (active = override the controller's)
+    void PublishVelocity(bool active, const Climb::Vec4& v, std::int64_t frame) {
+        climbers.command[kSlot].Publish({v, active, frame, Climb::LogRateLimiter::NowNs()});
+    }
+
+    // Point the hook at the player's current controller; nullptr until 3D is loaded again
+    void BindController(const RE::bhkCharacterController* controller) {
+        climbers.Bind(kSlot, ControllerKey(controller));
     }
 
     void CancelFallNumber() {
@@ -120,26 +84,25 @@ public:
         }
     }
 
-    void UpdateSpeedBuf() {
-        const auto actorRoot = netimmerse_cast<RE::BSFadeNode*>(player->Get3D());
-        if (!actorRoot) {
-            // log::warn("Fail to get actorRoot");
-            return;
-        }
-
-        const auto nodeNameL = "NPC L Hand [LHnd]"sv;
-        const auto nodeNameR = "NPC R Hand [RHnd]"sv;
+    // Hand velocity in the solver's scale (see kSolverVelocityScale)
+    Climb::Vec3 GetHandVelocity(int hand, const ClimbingSettings& settings) const {
+        auto estimator = static_cast<Climb::VelocityEstimator>(settings.iVelocityEstimator);
+        return handRing[hand].Velocity(estimator, settings.fVelocityWindow) * Climb::kSolverVelocityScale;
+    }
 
-        auto weaponNodeL = netimmerse_cast<RE::NiNode*>(actorRoot->GetObjectByName(nodeNameL));
-        auto weaponNodeR = netimmerse_cast<RE::NiNode*>(actorRoot->GetObjectByName(nodeNameR));
+    void UpdateSpeedBuf() {
+        auto weaponNodeL = handles.SkeletonHand(Climb::kLeft);
+        auto weaponNodeR = handles.SkeletonHand(Climb::kRight);
 
         if (weaponNodeL && weaponNodeR) {
             auto playerPos = player->GetPosition();
             auto handPosL = weaponNodeL->world.translate - playerPos;
             auto handPosR = weaponNodeR->world.translate - playerPos;
 
-            speedBuf.Push(handPosL, true);
-            speedBuf.Push(handPosR, false);
+            const double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            handRing[Climb::kLeft].Push(ToVec3(handPosL), now);
+            handRing[Climb::kRight].Push(ToVec3(handPosR), now);
+            bodyRing.Push(ToVec3(playerPos), now);
         }
     }
 };
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include "ClimbMath.h"
+
+// Batched, adaptive ray setup for CheckClimbCollision.
+// Ray endpoints for both hands are built together (SSE where available) directly in Havok
+// units, laid out as 16-byte float quads that copy straight into hkVector4.
+// How many rays a hand gets depends on how close a grab is:
+//   kProbe - hand far from anything: one extended forward ray that also measures approach
+//   kNear  - a surface is within probe reach: the legacy forward + forward-down pair
+//   kFan   - grip pressed while not holding: a 5-9 ray fan for reliable ledge catches
+// A hand that is moving while it reaches for a grab also gets a sweep ray, cast last, along its
+// predicted path over the look-ahead (fGrabLookAhead) plus fRayDist, so a fast lunge grabs the
+// surface it is about to cross instead of a frame or two late (or not at all).
+namespace Climb {
+
+    constexpr float kHavokScale = 0.0142875f;
+    constexpr float kRayStartOffset = 2.0f;  // Start rays slightly in front of the palm
+    constexpr float kProbeReach = 1.5f;      // Probe length as a multiple of fRayDist
+    constexpr int kMinFanRays = 5;
+    constexpr int kMaxFanRays = 9;
+    constexpr float kMinSweep = 2.0f;        // Predicted travel (units) below which no sweep ray is cast
+    constexpr int kMaxBatchRays = 2 * (kMaxFanRays + 1);
+
+    enum class ProbeMode : std::uint8_t { kNone, kProbe, kNear, kFan, kLegacy };
+
+    // Hand node world transform (rotation columns as used by the engine: right/forward/up).
+    struct HandRayPose {
+        Vec3 translate;
+        Vec3 right;
+        Vec3 forward;
+        Vec3 up;
+        Vec3 sweep;  // Predicted hand travel over the look-ahead (game units); zero = no sweep ray
+    };
+
+    struct RayBatch {
+        alignas(16) float from[kMaxBatchRays][4];  // Havok units
+        alignas(16) float to[kMaxBatchRays][4];
+        float length[kMaxBatchRays];               // Ray length (game units)
+        float grabDist[kMaxBatchRays];             // Hits further than this only count as "near"
+        bool predicted[kMaxBatchRays];             // Sweep ray along the predicted hand path
+        int first[2]{0, 0};
+        int count[2]{0, 0};
+    };
+
+    void BuildRayBatch(const HandRayPose poses[2], const ProbeMode modes[2], float rayDist, int fanRays,
+                       RayBatch& out);
+
+    struct RayStats {
+        std::uint64_t frames{0};
+        std::uint64_t rays{0};
+        std::uint64_t fanCasts{0};
+        std::uint64_t probeCasts{0};
+        std::uint64_t sweepCasts{0};
+        std::uint64_t grabs{0};
+        std::uint64_t predictedGrabs{0};  // Grabs only the sweep ray found
+
+        double RaysPerFrame() const { return frames ? static_cast<double>(rays) / frames : 0.0; }
+    };
+
+    // Chooses the probe mode per hand from the previous frame's result.
+    class RayFanPlanner {
+    public:
+        ProbeMode Plan(int hand, bool gripping, bool adaptive) const;
+
+        // Feed back the closest surface distance seen by the hand's rays (negative = nothing in reach).
+        void Report(int hand, float nearestDist, float rayDist);
+
+        void CountFrame(const ProbeMode modes[2], int raysCast, int sweepsCast);
+        void CountGrab(bool predicted) {
+            stats.grabs++;
+            if (predicted) stats.predictedGrabs++;
+        }
+        const RayStats& Stats() const { return stats; }
+        void ResetStats() { stats = {}; }
+        void Reset() { *this = RayFanPlanner(); }
+
+    private:
+        bool nearSurface[2]{false, false};
+        RayStats stats;
+    };
+
+}
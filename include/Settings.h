@@ -1,5 +1,14 @@
 #pragma once
 #include "SimpleIni.h"
+#include "ClimbSettings.h"
+#include "MaterialMatcher.h"
+#include "GripState.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 using namespace SKSE;
 using namespace SKSE::log;
@@ -7,52 +16,88 @@ using namespace SKSE::log;
 class Settings {
 public:
     [[nodiscard]] static Settings* GetSingleton();
-    
-    // Simplified struct for easy copying/overriding
-    struct ClimbingSettings {
-        float fStaminaCostMove{0.30f};
-        float fStaminaCostIdle{0.02f};
-        float fStaminaOneHandCostMult{2.0f}; 
-        float fStaminaMovementThreshold{10.0f};
-
-        float fForceMulti{1.0f};
-        float fRayDist{65.0f};
-        float fMaxArmLength{120.0f}; 
-        float fGrabSmoothing{0.2f};
-
-        float fThrowMult{1.2f};
-        float fThrowReleaseThreshold{200.0f};
-        float fThrowTimeWindow{0.5f}; // Time in seconds to "remember" peak velocity
-        float fMaxFlingVelocity{800.0f};
-
-        float fMaxVelocity{1500.0f}; 
-        float fMotionSmoothing{0.4f}; // [0.0 - 1.0]. Lower = Less Jitter/More Lag.
-        bool bEnableHaptics{true};
-        bool bEnableStamina{true};
-        bool bEnableWholeMod{true};
-        bool bDisableFallDamage{true}; // New option
+
+    // Simplified struct for easy copying/overriding (defined in ClimbSettings.h)
+    using ClimbingSettings = ::ClimbingSettings;
+
+    // Race overrides, one per [Race_<EditorID>] section (base settings + section keys)
+    struct RaceProfile {
+        std::string editorID;
+        RE::FormID raceID{0}; // 0 until the race forms are loaded and matched
+        ClimbingSettings settings;
+    };
+
+    // Everything read from one version of the INI. Never modified after it is published.
+    struct Snapshot {
+        ClimbingSettings defaultSettings; // The base settings from [Climbing]
+
+        // [Debug] Record every climbing frame to FreeClimbVR_Trace.bin (see tools/ClimbReplay)
+        bool bRecordTrace{false};
+        // [Debug] Periodically log the average number of climb rays cast per frame
+        bool bLogRayStats{false};
+        // [Debug] Seconds between stage timing reports (FREECLIMB_PROFILE builds). 0 = only when the console opens
+        float fProfileInterval{0.0f};
+        // [Debug] Write frame spans and events to FreeClimbVR_Events.json for Perfetto (FREECLIMB_PROFILE builds)
+        bool bTraceEvents{false};
+        // [Debug] sLogLevel: trace, debug, info, warn, err, critical or off
+        spdlog::level::level_enum logLevel{spdlog::level::info};
+
+        // [Materials] name/keyword patterns for Sound::PredictMaterial
+        Climb::MaterialMatcher materials;
+
+        // [Input] controller device -> hand table and grip button ID for InputManager
+        Climb::GripDecoder gripDecoder;
+
+        std::vector<RaceProfile> raceProfiles;
     };
 
-    void Load();
-    void ApplyRace(const std::string& raceName); // Apply overrides
+    // Starts the background thread that loads the INI, then re-loads it whenever the file
+    // changes on disk. Parsing and any write-back happen there, never on the game thread.
+    void StartWatcher();
+    // Game thread. Race forms exist now: index them by editor ID and re-load so [Race_*]
+    // sections resolve to FormIDs
+    void OnDataLoaded();
+
+    // Game thread, once per frame: adopt the newest published snapshot, if any
+    void Update();
 
-    ClimbingSettings defaultSettings; // The base settings from [Climbing]
-    ClimbingSettings activeSettings;  // The settings currently in use (Base + Race)
-    
-    // Map of Race EditorID -> Settings Override (Partial or Full)
-    std::map<std::string, ClimbingSettings> raceOverrides;
+    // Point activeSettings at the race's profile (race change events, game load)
+    void ApplyRace(RE::TESRace* race);
+
+    // Game thread only. Valid until the next Update().
+    const Snapshot& Current() const { return *current; }
+    const ClimbingSettings* activeSettings{nullptr}; // The settings currently in use (Base + Race)
 
 private:
-    Settings() = default;
+    Settings();
     Settings(const Settings&) = delete;
     Settings(Settings&&) = delete;
     ~Settings() = default;
 
     Settings& operator=(const Settings&) = delete;
     Settings& operator=(Settings&&) = delete;
+
+    // Lower-case race editor ID -> FormID, built on the game thread once data is loaded
+    using RaceIndex = std::unordered_map<std::string, RE::FormID>;
+    static std::shared_ptr<const RaceIndex> IndexRaces();
+
+    // Parse the INI into a new snapshot; the file is written only if keys were missing.
+    // Race profiles are matched through `races` (nullptr: before data load, left unmatched).
+    static std::shared_ptr<Snapshot> Load(const char* path, const RaceIndex* races);
+    void WatchLoop(std::stop_token stop);
+
+    std::shared_ptr<const Snapshot> current;
+    std::shared_ptr<const Snapshot> previous;  // Kept one more generation for late readers
+    std::atomic<std::shared_ptr<const Snapshot>> pending;
+
+    std::atomic<std::shared_ptr<const RaceIndex>> raceIndex;  // Set once by OnDataLoaded
+    std::atomic<bool> dataLoaded{false};
+    std::atomic<bool> reloadRequested{false};
+    RE::FormID currentRace{0};
+    std::jthread watcher;
 };
 
 // Global State Variables (Needed for OnFrame loop)
 extern int64_t iFrameCount;
 extern int64_t iLastPressGrip;
-extern std::chrono::steady_clock::time_point last_time;
\ No newline at end of file
+extern std::chrono::steady_clock::time_point last_time;
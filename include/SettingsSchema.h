@@ -0,0 +1,161 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include "ClimbSettings.h"
+
+// The [Climbing] / [Race_*] keys, described once: INI name, ClimbingSettings member, default,
+// valid range and the comment written next to a missing key. Settings.cpp loads, writes back and
+// clamps by walking this table, and the static_assert below keeps the table defaults and the
+// ClimbingSettings initializers from drifting apart. The order is the write-back order.
+// Values are parsed here too (SimpleIni's rules), so the headless benchmarks run the same code.
+namespace Climb {
+
+    enum class SettingType : std::uint8_t { kFloat, kInt, kBool };
+
+    struct SettingField {
+        const char* name;
+        SettingType type;
+        float ClimbingSettings::*f{nullptr};
+        int ClimbingSettings::*i{nullptr};
+        bool ClimbingSettings::*b{nullptr};
+        double defaultValue;
+        double min;
+        double max;
+        const char* comment;
+
+        constexpr double Get(const ClimbingSettings& s) const {
+            switch (type) {
+            case SettingType::kFloat: return s.*f;
+            case SettingType::kInt: return s.*i;
+            default: return s.*b ? 1.0 : 0.0;
+            }
+        }
+        constexpr void Set(ClimbingSettings& s, double value) const {
+            switch (type) {
+            case SettingType::kFloat: s.*f = static_cast<float>(value); break;
+            case SettingType::kInt: s.*i = static_cast<int>(value); break;
+            default: s.*b = value != 0.0; break;
+            }
+        }
+        // Stored value of the default (0.3 as a float is not 0.3 as a double)
+        constexpr bool IsDefault(const ClimbingSettings& s) const {
+            ClimbingSettings d{};
+            Set(d, defaultValue);
+            return Get(d) == Get(s);
+        }
+    };
+
+    constexpr SettingField FloatSetting(const char* name, float ClimbingSettings::*m, double def, double lo, double hi, const char* comment) {
+        return {name, SettingType::kFloat, m, nullptr, nullptr, def, lo, hi, comment};
+    }
+    constexpr SettingField IntSetting(const char* name, int ClimbingSettings::*m, int def, int lo, int hi, const char* comment) {
+        return {name, SettingType::kInt, nullptr, m, nullptr, static_cast<double>(def), static_cast<double>(lo), static_cast<double>(hi), comment};
+    }
+    constexpr SettingField BoolSetting(const char* name, bool ClimbingSettings::*m, bool def, const char* comment) {
+        return {name, SettingType::kBool, nullptr, nullptr, m, def ? 1.0 : 0.0, 0.0, 1.0, comment};
+    }
+
+    inline constexpr SettingField kClimbingFields[] = {
+        FloatSetting("fStaminaCostMove", &ClimbingSettings::fStaminaCostMove, 0.30, 0.0, 100.0, "# Stamina cost per frame while moving/climbing"),
+        FloatSetting("fStaminaCostIdle", &ClimbingSettings::fStaminaCostIdle, 0.02, 0.0, 100.0, "# Stamina cost per frame while just hanging"),
+        FloatSetting("fStaminaOneHandCostMult", &ClimbingSettings::fStaminaOneHandCostMult, 2.0, 0.0, 10.0, "# Stamina multiplier when using only 1 hand"),
+        FloatSetting("fMaxArmLength", &ClimbingSettings::fMaxArmLength, 120.0, 1.0, 1000.0, "# Maximum distance between hand and grab point before auto-release"),
+        FloatSetting("fMaxVelocity", &ClimbingSettings::fMaxVelocity, 1500.0, 0.0, 100000.0, "# Safety limit for velocity to avoid physics explosions"),
+        FloatSetting("fMaxFlingVelocity", &ClimbingSettings::fMaxFlingVelocity, 800.0, 0.0, 100000.0, "# Max vertical velocity for flung jumps"),
+        FloatSetting("fGrabSmoothing", &ClimbingSettings::fGrabSmoothing, 0.2, 0.0, 2.0, "# Time in seconds to smooth/dampen the grab impact"),
+        FloatSetting("fThrowMult", &ClimbingSettings::fThrowMult, 1.5, 0.0, 10.0, "# Multiplier for vertical velocity when throwing/flinging"),
+        FloatSetting("fForceMulti", &ClimbingSettings::fForceMulti, 1.1, 0.0, 10.0, "# General climbing speed multiplier"),
+        FloatSetting("fRayDist", &ClimbingSettings::fRayDist, 65.0, 1.0, 500.0, "# Max distance from hand to surface to grab"),
+        FloatSetting("fThrowReleaseThreshold", &ClimbingSettings::fThrowReleaseThreshold, 180.0, 0.0, 100000.0, "# Vertical velocity threshold to auto-release hands"),
+        FloatSetting("fThrowTimeWindow", &ClimbingSettings::fThrowTimeWindow, 0.6, 0.0, 5.0, "# Time window (seconds) to remember peak velocity for fling"),
+        FloatSetting("fStaminaMovementThreshold", &ClimbingSettings::fStaminaMovementThreshold, 10.0, 0.0, 100000.0, "# Velocity threshold to consider 'Moving' vs 'Idle'"),
+        FloatSetting("fMotionSmoothing", &ClimbingSettings::fMotionSmoothing, 0.4, 0.0, 1.0, "# Motion smoothing per 90 Hz frame [0.0 - 1.0]. 1.0 = raw input, lower = smoother but laggier"),
+        IntSetting("iMotionFilter", &ClimbingSettings::iMotionFilter, 0, 0, 1, "# Climb motion filter: 0 = fMotionSmoothing (exponential), 1 = One Euro (adaptive: steadier when hanging, less lag on fast pulls)"),
+        FloatSetting("fOneEuroMinCutoff", &ClimbingSettings::fOneEuroMinCutoff, 1.0, 0.01, 100.0, "# One Euro: cutoff (Hz) when still. Lower = less jitter while hanging"),
+        FloatSetting("fOneEuroBeta", &ClimbingSettings::fOneEuroBeta, 5.0, 0.0, 1000.0, "# One Euro: how fast the cutoff rises with motion. Higher = less lag on fast pulls"),
+        FloatSetting("fOneEuroDCutoff", &ClimbingSettings::fOneEuroDCutoff, 1.0, 0.01, 100.0, "# One Euro: cutoff (Hz) for the motion speed estimate"),
+        IntSetting("iVelocityEstimator", &ClimbingSettings::iVelocityEstimator, 0, 0, 1, "# Hand velocity estimate: 0 = line fit (default), 1 = Savitzky-Golay (smoother at high refresh rates, use fVelocityWindow >= 0.04)"),
+        FloatSetting("fVelocityWindow", &ClimbingSettings::fVelocityWindow, 0.025, 0.005, 0.4, "# Seconds of hand motion the velocity is measured over (0.025 = the old 3-frame window at 90 Hz)"),
+        IntSetting("iRayFanSize", &ClimbingSettings::iRayFanSize, 7, 5, 9, "# Rays per hand while reaching for a grab (5 - 9). More = better ledge catches"),
+        BoolSetting("bAdaptiveRays", &ClimbingSettings::bAdaptiveRays, true, "# Cast a single probe ray when far from surfaces and a fan only when grabbing"),
+        FloatSetting("fGrabLookAhead", &ClimbingSettings::fGrabLookAhead, 40.0, 0.0, 200.0, "# Milliseconds ahead along the hand's path a grab can reach (catches ledges on fast lunges). 0 = off"),
+        FloatSetting("fHoverCacheMove", &ClimbingSettings::fHoverCacheMove, 2.0, 0.0, 100.0, "# Hand travel (units) before a hover raycast is redone. 0 = raycast every frame"),
+        FloatSetting("fHoverCacheAngle", &ClimbingSettings::fHoverCacheAngle, 6.0, 0.0, 180.0, "# Hand rotation (degrees) before a hover raycast is redone"),
+        IntSetting("iHoverCacheFrames", &ClimbingSettings::iHoverCacheFrames, 8, 0, 1000, "# Redo hover raycasts at least every N frames"),
+        IntSetting("iSurfaceCacheSize", &ClimbingSettings::iSurfaceCacheSize, 4096, 0, 65536, "# Surface samples remembered per cell for hover detection (0 = off, max 65536)"),
+        IntSetting("iMaxClimbVoices", &ClimbingSettings::iMaxClimbVoices, 4, 1, 8, "# Climb sounds allowed to play at once (1 - 8). The oldest is cut off beyond that"),
+        FloatSetting("fClimbSoundCooldown", &ClimbingSettings::fClimbSoundCooldown, 0.12, 0.0, 5.0, "# Minimum seconds between grab sounds of the same hand"),
+        BoolSetting("bEnableHaptics", &ClimbingSettings::bEnableHaptics, true, "# Enable controller vibration on grab"),
+        FloatSetting("fHapticStrength", &ClimbingSettings::fHapticStrength, 1.0, 0.0, 10.0, "# Haptic strength multiplier (1.0 = normal, 0.0 = off)"),
+        BoolSetting("bUseVRIKHaptics", &ClimbingSettings::bUseVRIKHaptics, false, "# Use VRIK's haptic pulses instead of Game.ShakeController"),
+        BoolSetting("bEnableStamina", &ClimbingSettings::bEnableStamina, true, "# Enable stamina drain system"),
+        BoolSetting("bDisableFallDamage", &ClimbingSettings::bDisableFallDamage, true, "# No fall damage after letting go of a climb"),
+        BoolSetting("bEnableWholeMod", &ClimbingSettings::bEnableWholeMod, true, "# Master switch for the mod"),
+    };
+
+    // Case-insensitive, like SimpleIni's key lookup
+    constexpr const SettingField* FindSetting(std::string_view name) {
+        auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+        for (const auto& field : kClimbingFields) {
+            std::string_view fieldName = field.name;
+            if (fieldName.size() != name.size()) continue;
+            bool same = true;
+            for (std::size_t c = 0; c < name.size() && same; c++) same = lower(fieldName[c]) == lower(name[c]);
+            if (same) return &field;
+        }
+        return nullptr;
+    }
+
+    // Returns true if the value was out of range (it is clamped in place)
+    constexpr bool ClampSetting(const SettingField& field, ClimbingSettings& s) {
+        const double value = field.Get(s);
+        const double clamped = value != value ? field.defaultValue : std::clamp(value, field.min, field.max);  // NaN -> default
+        if (clamped == value) return false;
+        field.Set(s, clamped);
+        return true;
+    }
+
+    // Parse an INI value for the field: numbers must be the whole string (ints also take 0x hex),
+    // bools take true/false, yes/no, on/off, 1/0. False = not a valid value (the setting is kept).
+    bool ParseSettingValue(const SettingField& field, const char* text, double& out);
+
+    enum class FieldIssue : std::uint8_t { kInvalid, kClamped };
+
+    // Recompute ClimbingSettings::derived. Call after any field changes (Settings does it per load).
+    constexpr void UpdateDerived(ClimbingSettings& s) {
+        s.derived.maxArmLengthSq = s.fMaxArmLength * s.fMaxArmLength;
+        s.derived.motionAlpha = std::clamp(s.fMotionSmoothing, 0.01f, 1.0f);  // Avoid complete freeze
+    }
+
+    // Read every field through lookup(name) -> const char* (nullptr = key absent); absent keys keep
+    // their current value. report(field, FieldIssue, text) is called for unparsable and clamped values.
+    template <class Lookup, class Report>
+    void LoadFields(ClimbingSettings& s, Lookup&& lookup, Report&& report) {
+        for (const auto& field : kClimbingFields) {
+            const char* text = lookup(field.name);
+            if (!text) continue;
+            double value;
+            if (!ParseSettingValue(field, text, value)) {
+                report(field, FieldIssue::kInvalid, text);
+                continue;
+            }
+            field.Set(s, value);
+            if (ClampSetting(field, s)) report(field, FieldIssue::kClamped, text);
+        }
+        UpdateDerived(s);
+    }
+
+    // Defaults equal to the initializers and inside their range; no name listed twice
+    constexpr bool SchemaIsConsistent() {
+        const ClimbingSettings s{};
+        for (const auto& field : kClimbingFields) {
+            if (!field.IsDefault(s) || field.defaultValue < field.min || field.defaultValue > field.max) return false;
+            if (FindSetting(field.name) != &field) return false;
+        }
+        ClimbingSettings derived = s;
+        UpdateDerived(derived);
+        return derived.derived.maxArmLengthSq == s.derived.maxArmLengthSq && derived.derived.motionAlpha == s.derived.motionAlpha;
+    }
+    static_assert(SchemaIsConsistent(), "ClimbingSettings initializers disagree with kClimbingFields");
+}
@@ -1,7 +1,14 @@
 #pragma once
 #include <RE/Skyrim.h>
+#include "FormClassCache.h"
 
 namespace Sound {
-    // Play a climbing impact sound based on the surface material
-    void PlayClimbSound(RE::TESObjectREFR* surfaceRef, RE::Actor* player);
+    // Guess the surface material of a base object (uncached; see GetSurfaceClass)
+    Climb::Material PredictMaterial(RE::TESBoundObject* base);
+
+    // Resolve the per-material sound descriptors (kDataLoaded)
+    void ResolveSounds();
+
+    // Play a climbing impact sound based on the surface material, at the grabbing hand
+    void PlayClimbSound(RE::TESObjectREFR* surfaceRef, RE::NiAVObject* handNode, bool isLeft);
 }
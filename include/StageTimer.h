@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "EventTrace.h"
+
+// Per-stage frame timing. Each stage feeds a log-bucketed histogram (4 buckets per power of two,
+// so about 19% resolution from 1 ns to a few seconds) that any thread can record into without a
+// lock: HookSetVelocity runs on the physics side, the rest on the main thread.
+// While the event tracer runs, each timed stage is also written to the trace as a span.
+// The CLIMB_PROFILE_STAGE macro compiles to nothing unless FREECLIMB_PROFILE is defined.
+namespace Climb {
+
+    enum class Stage : std::uint8_t {
+        kClimbMain,     // Whole ClimbMain
+        kSpeedBuffer,   // PlayerState::UpdateSpeedBuf
+        kCollision,     // CheckClimbCollision
+        kSolve,         // ClimbSolver::Step
+        kHaptics,       // FlushHaptics
+        kSound,         // Sound::PlayClimbSound
+        kActorValues,   // Stamina reads and writes
+        kSetVelocity,   // HookSetVelocity
+        kCount
+    };
+
+    const char* StageName(Stage stage);
+
+    struct StageSummary {
+        std::uint64_t count{0};
+        std::uint64_t p50Ns{0};
+        std::uint64_t p99Ns{0};
+        std::uint64_t maxNs{0};
+        double meanNs{0.0};
+    };
+
+    class LogHistogram {
+    public:
+        static constexpr int kBuckets = 128;  // Up to 2^33 ns
+
+        static int Bucket(std::uint64_t ns);
+        static std::uint64_t BucketMid(int bucket);  // Middle of the bucket's range
+
+        void Record(std::uint64_t ns) {
+            counts[Bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(1, std::memory_order_relaxed);
+            sumNs.fetch_add(ns, std::memory_order_relaxed);
+            auto seen = maxNs.load(std::memory_order_relaxed);
+            while (ns > seen && !maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+        }
+
+        // Percentiles are bucket midpoints; the max is exact. Samples recorded while this runs
+        // may or may not be included.
+        StageSummary Summarize() const;
+        void Reset();
+
+    private:
+        std::atomic<std::uint32_t> counts[kBuckets]{};
+        std::atomic<std::uint64_t> total{0};
+        std::atomic<std::uint64_t> sumNs{0};
+        std::atomic<std::uint64_t> maxNs{0};
+    };
+
+    class StageProfiler {
+    public:
+        static StageProfiler& Get();
+
+        void Record(Stage stage, std::uint64_t ns) { stages[static_cast<int>(stage)].Record(ns); }
+        StageSummary Summarize(Stage stage) const { return stages[static_cast<int>(stage)].Summarize(); }
+        void Reset();
+
+    private:
+        LogHistogram stages[static_cast<int>(Stage::kCount)];
+    };
+
+    class ScopedStageTimer {
+    public:
+        explicit ScopedStageTimer(Stage stage, StageProfiler& profiler = StageProfiler::Get())
+            : profiler(profiler), stage(stage), start(std::chrono::steady_clock::now()) {}
+        ~ScopedStageTimer() {
+            const auto end = std::chrono::steady_clock::now();
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            profiler.Record(stage, ns > 0 ? static_cast<std::uint64_t>(ns) : 0);
+            if (auto& tracer = EventTracer::Get(); tracer.Enabled()) tracer.Span(StageName(stage), start, end);
+        }
+        ScopedStageTimer(const ScopedStageTimer&) = delete;
+        ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+    private:
+        StageProfiler& profiler;
+        Stage stage;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+#define CLIMB_PROFILE_CONCAT2(a, b) a##b
+#define CLIMB_PROFILE_CONCAT(a, b) CLIMB_PROFILE_CONCAT2(a, b)
+#ifdef FREECLIMB_PROFILE
+    // Times the rest of the enclosing scope
+    #define CLIMB_PROFILE_STAGE(stage) ::Climb::ScopedStageTimer CLIMB_PROFILE_CONCAT(climbStageTimer, __LINE__){::Climb::Stage::stage}
+#else
+    #define CLIMB_PROFILE_STAGE(stage) ((void)0)
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ClimbMath.h"
+
+// Spatial hash of recently seen surface samples in the current cell.
+// Every raycast hit (climbable or not) is remembered under its quantized world position, so
+// hover detection can be answered from memory when the hand reaches toward a wall it has
+// already touched. Grabs still cast a real ray.
+// The table is open-addressed with a fixed capacity and a bounded probe window; when the
+// window is full the least recently used sample is evicted, so memory never grows.
+namespace Climb {
+
+    struct SurfaceSample {
+        Vec3 point;
+        Vec3 normal;
+        std::uint32_t refrFormID{0};
+        std::uint8_t layer{0};
+        bool climbable{false};
+    };
+
+    struct SurfaceQueryHit {
+        bool hit{false};
+        float distance{0.0f};
+        SurfaceSample sample;
+    };
+
+    struct SurfaceHashStats {
+        std::uint64_t inserts{0};
+        std::uint64_t evictions{0};
+        std::uint64_t queries{0};
+        std::uint64_t answered{0};  // Queries answered from memory
+    };
+
+    class SurfaceHash {
+    public:
+        static constexpr float kCellSize = 8.0f;  // Quantization step (game units)
+        static constexpr int kProbeWindow = 8;
+        static constexpr std::uint32_t kMaxAge = 600;  // Frames before a sample is distrusted
+
+        // capacity is rounded up to a power of two; 0 disables the hash.
+        void Reset(std::size_t capacity);
+        void Clear();
+        std::size_t Capacity() const { return slots.size(); }
+        std::size_t MemoryBytes() const { return slots.capacity() * sizeof(Slot); }
+
+        void Insert(const SurfaceSample& sample, std::uint32_t tick);
+
+        // Walks the hand's forward ray up to maxDist and returns the first remembered climbable
+        // surface whose plane the ray crosses. hit = false means "unknown": cast a real ray.
+        SurfaceQueryHit Query(const Vec3& start, const Vec3& dir, float maxDist, std::uint32_t tick);
+
+        const SurfaceHashStats& Stats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+    private:
+        struct Slot {
+            std::uint64_t key{0};
+            std::uint32_t lastUsed{0};
+            bool used{false};
+            SurfaceSample sample;
+        };
+
+        static std::uint64_t KeyOf(const Vec3& p);
+        std::size_t IndexOf(std::uint64_t key) const;
+        Slot* Find(std::uint64_t key, std::uint32_t tick);
+
+        std::vector<Slot> slots;
+        std::size_t mask{0};
+        SurfaceHashStats stats;
+    };
+
+}
@@ -2,10 +2,32 @@
 #include <random>
 #include <sstream>
 #include "settings.h"
+#include "ClimbMath.h"
+#include "ClimbVec4.h"
+#include "ClimbSolver.h"
+#include "RayFan.h"
+#include "SurfaceHash.h"
+#include "FormClassCache.h"
+#include "HapticQueue.h"
+#include "EngineHandles.h"
+#include "StageTimer.h"
+#include "LogLimiter.h"
 
 using namespace SKSE;
 using namespace SKSE::log;
 
+// Rate-limited logging for per-frame paths: at most one line per `seconds` from this call site,
+// e.g. CLIMB_LOG_EVERY(info, 2.0, "Slipped on ICE!"). Suppressed lines are counted in the next one.
+#define CLIMB_LOG_EVERY(level, seconds, fmt, ...)                                                                         \
+    do {                                                                                                                 \
+        static ::Climb::LogRateLimiter climbLogLimiter;                                                                  \
+        std::uint32_t climbLogRepeats = 0;                                                                               \
+        if (climbLogLimiter.Allow(::Climb::LogRateLimiter::NowNs(), static_cast<std::int64_t>((seconds) * 1e9), climbLogRepeats)) { \
+            if (climbLogRepeats) SKSE::log::level(fmt " (repeated {} times)" __VA_OPT__(,) __VA_ARGS__, climbLogRepeats);  \
+            else SKSE::log::level(fmt __VA_OPT__(,) __VA_ARGS__);                                                         \
+        }                                                                                                                \
+    } while (0)
+
 // Core Form/Global Lookups
 uint32_t GetBaseFormID(uint32_t formId);
 uint32_t GetFullFormID(const uint8_t modIndex, uint32_t formLower);
@@ -17,21 +39,72 @@ uint32_t GetFullFormID_ESL(const uint8_t modIndex, const uint16_t esl_index, uin
 std::string formatNiPoint3(RE::NiPoint3& pos);
 
 // Haptics
+// vibrateController only queues the pulse; FlushHaptics sends the frame's pulses
+// (once per frame) through the backend picked by ResolveHapticBackend (kDataLoaded / reload).
 void vibrateController(int hapticFrame, int length, bool isLeft);
+void FlushHaptics();
+void ResolveHapticBackend();
+const Climb::HapticStats& GetHapticStats();
+void ResetHapticStats();
+
+// Stage timings (FREECLIMB_PROFILE builds): p50/p99/max per stage to the SKSE log, and the console
+void LogStageTimings(bool toConsole);
 
 // Positions & Physics
 // Positions & Physics
 RE::NiPoint3 GetPlayerHandPos(bool isLeft, RE::Actor* player);
-RE::NiPoint3 Quad2Velo(RE::hkVector4& a_velocity);
+
+// Engine <-> headless solver conversions
+inline Climb::Vec3 ToVec3(const RE::NiPoint3& p) { return {p.x, p.y, p.z}; }
+inline RE::NiPoint3 ToNiPoint3(const Climb::Vec3& v) { return {v.x, v.y, v.z}; }
+
+// Climb velocity <-> Havok: a register copy when Vec4 is SSE (w = 0 either way)
+#ifdef FREECLIMB_SSE
+inline Climb::Vec4 ToVec4(const RE::hkVector4& v) { return Climb::Vec4::FromQuad(v.quad); }
+inline RE::hkVector4 ToHkVector4(const Climb::Vec4& v) {
+    RE::hkVector4 h;
+    h.quad = v.Quad();
+    return h;
+}
+#else
+inline Climb::Vec4 ToVec4(const RE::hkVector4& v) { return {v.quad.m128_f32[0], v.quad.m128_f32[1], v.quad.m128_f32[2]}; }
+inline RE::hkVector4 ToHkVector4(const Climb::Vec4& v) { return RE::hkVector4(v.X(), v.Y(), v.Z(), 0.0f); }
+#endif
+
+// ClimberPool key: the bhkCharacterController base, so Actor::GetCharController() and the proxy the
+// SetVelocity hook receives map to the same address
+inline std::uintptr_t ControllerKey(const RE::bhkCharacterController* controller) {
+    return reinterpret_cast<std::uintptr_t>(controller);
+}
 
 // Raycast Result
 struct ClimbHitData {
     bool hit{ false };
     RE::NiPoint3 normal;
-    RE::TESObjectREFR* refr{ nullptr };
+    RE::TESObjectREFR* refr{ nullptr }; // Only on the frame it was cast (see Remembered)
+    RE::FormID formID{ 0 };             // refr's, kept when the hit is remembered
+    float distance{ 0.0f }; // Hand (ray start) to surface, game units
+    RE::NiPoint3 point;     // Hit position (with normal: the surface plane)
+    std::uint32_t layer{ 0 };
+    bool predicted{ false }; // Found by the look-ahead sweep ray
 };
 
-// Collision Detection
-ClimbHitData CheckClimbCollision(RE::Actor* player, bool isLeft, float rayDist);
+// The hit as the hover cache keeps it: references can be disabled or deleted between frames,
+// so only the formID outlives the cast
+inline ClimbHitData Remembered(ClimbHitData hit) {
+    hit.refr = nullptr;
+    return hit;
+}
+
+// Collision Detection (both hands in one batch; only hands with probe[i] set are cast)
+// Rays start at hands[i].position, oriented by the hand node; the hand velocity drives the
+// look-ahead sweep ray of gripping hands (fGrabLookAhead).
+void CheckClimbCollision(const EngineHandles& handles, const bool probe[2], const Climb::HandInput hands[2],
+                         float rayDist, Climb::RayFanPlanner& planner, Climb::SurfaceHash* surfaces, ClimbHitData out[2]);
 bool IsIce(RE::TESObjectREFR* ref);
-bool IsClimbingTool(RE::Actor* player, bool isLeft);
\ No newline at end of file
+bool IsClimbingTool(RE::Actor* player, bool isLeft);
+
+// Surface classification packed per base form (whitelist, ice, material; see FormClassCache.h).
+// Computed on first sight, then one hash probe.
+std::uint8_t GetSurfaceClass(RE::TESBoundObject* base);
+void ResetSurfaceClassCache(); // Data reload / game load
\ No newline at end of file
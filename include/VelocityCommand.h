@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include "ClimbVec4.h"
+
+// The climb velocity ClimbMain hands to HookSetVelocity. The hook runs from the character
+// controller update, which may be another thread and may land in the middle of a frame's write,
+// so the command is published through a seqlock: the reader retries until it copies a snapshot
+// no write overlapped, and never blocks the writer. Each command carries the frame and time it
+// was issued so the physics side can ignore one that ClimbMain stopped refreshing.
+namespace Climb {
+
+    struct VelocityCommand {
+        Vec4 velocity;
+        bool active{false};        // Replace the controller's velocity with `velocity`
+        std::int64_t frame{0};     // Frame sequence (iFrameCount) it was issued on
+        std::int64_t timeNs{0};    // Steady clock, ns
+
+        bool IsFresh(std::int64_t nowNs, std::int64_t maxAgeNs) const { return nowNs - timeNs <= maxAgeNs; }
+    };
+
+    // Single writer (the frame thread), any number of lock-free readers.
+    class VelocityCommandSlot {
+    public:
+        void Publish(const VelocityCommand& cmd) {
+            const auto s = seq.load(std::memory_order_relaxed);
+            seq.store(s + 1, std::memory_order_relaxed);  // Odd: write in progress
+            std::atomic_thread_fence(std::memory_order_release);
+            words[0].store(Pack(cmd.velocity.X(), cmd.velocity.Y()), std::memory_order_relaxed);
+            words[1].store(Pack(cmd.velocity.Z(), cmd.active ? 1.0f : 0.0f), std::memory_order_relaxed);
+            words[2].store(static_cast<std::uint64_t>(cmd.frame), std::memory_order_relaxed);
+            words[3].store(static_cast<std::uint64_t>(cmd.timeNs), std::memory_order_relaxed);
+            seq.store(s + 2, std::memory_order_release);
+        }
+
+        void Clear() { Publish({}); }
+
+        // Consistent copy of the last published command
+        VelocityCommand Read() const {
+            std::uint64_t w[4];
+            for (;;) {
+                const auto s = seq.load(std::memory_order_acquire);
+                if (s & 1) continue;
+                for (int i = 0; i < 4; i++) w[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq.load(std::memory_order_relaxed) == s) break;
+            }
+            VelocityCommand cmd;
+            cmd.velocity = Vec4(Low(w[0]), High(w[0]), Low(w[1]));
+            cmd.active = High(w[1]) != 0.0f;
+            cmd.frame = static_cast<std::int64_t>(w[2]);
+            cmd.timeNs = static_cast<std::int64_t>(w[3]);
+            return cmd;
+        }
+
+    private:
+        static std::uint64_t Pack(float lo, float hi) {
+            return std::bit_cast<std::uint32_t>(lo) | (std::uint64_t{std::bit_cast<std::uint32_t>(hi)} << 32);
+        }
+        static float Low(std::uint64_t w) { return std::bit_cast<float>(static_cast<std::uint32_t>(w)); }
+        static float High(std::uint64_t w) { return std::bit_cast<float>(static_cast<std::uint32_t>(w >> 32)); }
+
+        std::atomic<std::uint32_t> seq{0};
+        std::atomic<std::uint64_t> words[4]{};
+    };
+
+}
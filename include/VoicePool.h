@@ -0,0 +1,60 @@
+#pragma once
+
+// Voice allocation for climb sounds.
+// A fixed number of voice slots is shared by both hands. Each hand has a cooldown so fast
+// hand-over-hand climbing cannot retrigger faster than the sound can be heard, and when every
+// slot is busy the oldest voice is stolen instead of stacking another one.
+namespace Climb {
+
+    class VoicePool {
+    public:
+        static constexpr int kMaxVoices = 8;
+
+        struct Params {
+            int maxVoices{4};
+            float voiceSeconds{0.6f};   // How long a started voice is considered busy
+            float handCooldown{0.12f};  // Minimum seconds between two sounds of one hand
+        };
+
+        // Slot to play on, or -1 while the hand is cooling down.
+        // evict = the slot held a voice before (stolen, or past voiceSeconds but possibly still
+        // audible) that must be stopped before its handle is reused.
+        int Acquire(int hand, float now, const Params& params, bool& evict) {
+            evict = false;
+            if (handPlayed[hand] && now - lastHandPlay[hand] < params.handCooldown) return -1;
+
+            int voices = params.maxVoices < 1 ? 1 : (params.maxVoices > kMaxVoices ? kMaxVoices : params.maxVoices);
+            int slot = -1;
+            int oldest = 0;
+            for (int i = 0; i < voices; i++) {
+                if (!used[i] || now - started[i] >= params.voiceSeconds) {
+                    slot = i;
+                    break;
+                }
+                if (started[i] < started[oldest]) oldest = i;
+            }
+            if (slot < 0) {
+                slot = oldest;
+                stolen++;
+            }
+            evict = used[slot];
+
+            used[slot] = true;
+            started[slot] = now;
+            handPlayed[hand] = true;
+            lastHandPlay[hand] = now;
+            return slot;
+        }
+
+        void Reset() { *this = VoicePool(); }
+        unsigned Stolen() const { return stolen; }
+
+    private:
+        bool used[kMaxVoices]{};
+        float started[kMaxVoices]{};
+        bool handPlayed[2]{};
+        float lastHandPlay[2]{};
+        unsigned stolen{0};
+    };
+
+}
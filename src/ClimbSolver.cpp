@@ -0,0 +1,278 @@
+#include "ClimbSolver.h"
+
+using namespace Climb;
+
+bool ClimbSolver::WantsProbe(int hand, bool gripping) const {
+    // A released grip clears the hold, so the hand goes back to hover detection.
+    if (!gripping) return true;
+    const auto& h = hands[hand];
+    return !h.mustRelease && !h.isHolding;
+}
+
+void ClimbSolver::Reset() { *this = ClimbSolver(); }
+
+void ClimbSolver::UpdateRetainedNormal() {
+    const Vec3 normals[2] = {hands[kLeft].wallNormal, hands[kRight].wallNormal};
+    const bool holding[2] = {hands[kLeft].isHolding, hands[kRight].isHolding};
+    AverageNormal(normals, holding, retainedWallNormal);
+}
+
+bool ClimbSolver::CheckHand(int hand, const HandInput& in, const ClimbingSettings& settings, HandEvents& events) {
+    auto& h = hands[hand];
+
+    // Handle Release
+    if (!in.gripping) {
+        h.isHolding = false;
+        h.mustRelease = false;
+        // DO NOT RETURN! We must check for Hover.
+    }
+
+    if (h.mustRelease) return false; // Wait for release
+    if (!in.tracked) return false;
+
+    bool collision = false;
+
+    // RAYCAST CHECK
+    // The caller probes every frame while not holding, to allow hover detection
+    if (!h.isHolding) {
+        const auto& hit = in.hit;
+        if (hit.hit) {
+            // --- HOVER LOGIC ---
+            if (!in.gripping && settings.bEnableHaptics) {
+                // Subtle Pulse: Intensity 1 (Min), Duration 1ms, Interval 15 frames
+                if (h.hoverSkip++ > 15) {
+                    events.hoverPulse = true;
+                    h.hoverSkip = 0;
+                }
+            }
+
+            // --- GRAB LOGIC ---
+            if (in.gripping) {
+                bool canGrab = true;
+                if (hit.refrFormID != 0) {
+                    // 1. Self Grab Prevention (fail grab silently)
+                    if (hit.refrFormID == kPlayerRefID) {
+                        canGrab = false;
+                    }
+                    // 2. Ice Check
+                    else if (hit.isIce && !in.hasClimbingTool) {
+                        events.iceSlip = true;
+                        canGrab = false;
+                    }
+                }
+                // Static World Geometry -> Always grabbable
+
+                if (canGrab) {
+                    collision = true;
+                    h.isHolding = true;
+                    h.grabPoint = in.position;
+                    h.wallNormal = hit.normal;
+
+                    events.grabbed = true;
+
+                    // Haptic Feedback (CLICK)
+                    if (h.hapticCool <= 0 && settings.bEnableHaptics) {
+                        events.clickPulse = true;
+                        h.hapticCool = 30;
+                    }
+                }
+            }
+        } else {
+            // No hit, reset hoverskip to avoid "stored" tick
+            h.hoverSkip = 10;
+        }
+    } else {
+        // Already Holding - Sticky Logic
+        collision = true;
+
+        // Check Arm Stretch
+        if ((in.position - h.grabPoint).SqrLength() > settings.derived.maxArmLengthSq) {
+            h.isHolding = false;
+            h.mustRelease = true;
+            collision = false;
+        }
+    }
+
+    return collision;
+}
+
+FrameCommand ClimbSolver::Step(const FrameInput& in, const ClimbingSettings& settings) {
+    FrameCommand cmd;
+    cmd.setVelocity = lastSetVelocity;
+    cmd.velocity = lastVelocity;
+
+    float dt = in.dt;
+
+    // Haptic Cooldowns
+    for (auto& h : hands) {
+        if (h.hapticCool > 0) h.hapticCool--;
+    }
+
+    Vec4 totalClimbVelo;
+    bool isClimbing = false;
+    int handsActive = 0;
+
+    for (int hand = kLeft; hand <= kRight; hand++) {
+        if (CheckHand(hand, in.hands[hand], settings, cmd.hands[hand])) {
+            handsActive++;
+            totalClimbVelo -= Vec4(in.hands[hand].velocity);
+            isClimbing = true;
+        }
+    }
+
+    if (isClimbing) {
+        UpdateRetainedNormal(); // Update normal continuously while holding
+        postReleaseTimer = 0.0f;
+
+        // Transition Check (Start of climb)
+        if (!wasClimbing) {
+            // Reset Peak Tracker
+            entryVelo = {};
+            peakThrowVelo = {};
+
+            // Capture current falling velocity
+            if (in.hasCharController) {
+                entryVelo = in.charVelocity;
+
+                // Smart Smoothing:
+                // Only smooth if we already had significant momentum (flying/falling).
+                // If we were stopped/grounded, DO NOT SMOOTH. Only immediate velocity can break ground friction.
+                if (entryVelo.Length() < 50.0f) {
+                    smoothingTimer = 0.0f; // Instant grab from ground
+                } else {
+                    smoothingTimer = settings.fGrabSmoothing;
+                }
+            } else {
+                smoothingTimer = 0.0f;
+            }
+
+            // Cancel Jump Animation (Global - Once per climb)
+            cmd.startedClimb = true;
+        }
+
+        // Stamina Logic (Consider < 1.0 as depleted to be safe)
+        if (settings.bEnableStamina && in.stamina >= 0.0f && in.stamina <= 1.0f) {
+            // Force Release
+            cmd.staminaDepleted = true;
+            for (auto& h : hands) {
+                h.isHolding = false;
+                h.mustRelease = true;
+            }
+        } else {
+            // Apply Velocity
+            totalClimbVelo = totalClimbVelo * settings.fForceMulti;
+
+            // SMOOTHING BLEND
+            // Ramp by time elapsed at the end of this frame, so the blend covers fGrabSmoothing
+            // seconds at any refresh rate.
+            if (smoothingTimer > 0.0f && settings.fGrabSmoothing > 0.0f) {
+                smoothingTimer -= dt;
+                totalClimbVelo = GrabBlend(entryVelo, totalClimbVelo, smoothingTimer, settings.fGrabSmoothing);
+            }
+
+            // --- V2.4 MOTION SMOOTHING (Fix Jitter/Disorientation) ---
+            // Filters out high-frequency noise from hand tracking and sudden spikes.
+            // Reset history on new climb
+            if (!wasClimbing) {
+                lastFrameVelo = totalClimbVelo;
+                motionFilter.Reset(totalClimbVelo.ToVec3());
+            }
+
+            if (settings.iMotionFilter == static_cast<int>(MotionFilterMode::kOneEuro)) {
+                OneEuroFilter::Params euro{settings.fOneEuroMinCutoff, settings.fOneEuroBeta, settings.fOneEuroDCutoff};
+                totalClimbVelo = Vec4(motionFilter.Filter(totalClimbVelo.ToVec3(), dt, euro));
+            } else {
+                const float kAlpha = ExpAlpha(settings.derived.motionAlpha, dt); // fMotionSmoothing is per 90 Hz frame
+
+                totalClimbVelo = (totalClimbVelo * kAlpha) + (lastFrameVelo * (1.0f - kAlpha));
+            }
+            lastFrameVelo = totalClimbVelo;
+
+            // Stamina Drain
+            if (settings.bEnableStamina) {
+                float velocityMagnitude = totalClimbVelo.Length();
+                float staminaCost = (velocityMagnitude > settings.fStaminaMovementThreshold) ? settings.fStaminaCostMove
+                                                                                             : settings.fStaminaCostIdle;
+                // One Hand Penalty
+                if (handsActive == 1) {
+                    staminaCost *= settings.fStaminaOneHandCostMult;
+                }
+                cmd.staminaCost = staminaCost;
+            }
+
+            // Fling / Throw Mechanics
+            if (handsActive >= 2 && totalClimbVelo.Z() > 0.0f) {
+                totalClimbVelo = totalClimbVelo * Vec4(1.0f, 1.0f, settings.fThrowMult); // Climbing boost
+
+                if (totalClimbVelo.Z() > settings.fThrowReleaseThreshold) {
+                    // Strong fling detected
+                    for (auto& h : hands) {
+                        h.isHolding = false;
+                        h.mustRelease = true;
+                    }
+                }
+            }
+
+            // SAFETY: Clamp Maximum Velocity (Anti-Space Launch)
+            totalClimbVelo = ClampLength(totalClimbVelo, settings.fMaxVelocity);
+
+            lastAppliedVelo = totalClimbVelo; // Store for release
+
+            // TRACK PEAK VELOCITY (For generous throw window)
+            if (totalClimbVelo.Z() > peakThrowVelo.Z()) {
+                peakThrowVelo = totalClimbVelo;
+                peakThrowTimer = settings.fThrowTimeWindow;
+            }
+            peakThrowTimer -= dt;
+            if (peakThrowTimer <= 0.0f) {
+                peakThrowVelo = totalClimbVelo; // Reset to current if timed out
+            }
+
+            cmd.velocity = totalClimbVelo;
+            cmd.setVelocity = true;
+
+            // ALWAYS Reset Fall Logic while holding (Essential for correct "Normal" physics)
+            cmd.resetFallState = true;
+            cmd.resetFallAnim = true;
+        }
+    } else {
+        cmd.setVelocity = false;
+
+        // SAFETY: Post-Climb Immunity (If Enabled)
+        if (postReleaseTimer > 0.0f && settings.bDisableFallDamage) {
+            cmd.resetFallState = true;
+        }
+
+        // MOMENTUM INJECTION (The Fling Fix)
+        if (wasClimbing) {
+            postReleaseTimer = 2.0f;
+
+            // We just released the wall. Transfer momentum to game physics.
+            if (in.hasCharController) {
+                // Use Peak if it offers better upward momentum (Fling)
+                Vec4 launchVelo = lastAppliedVelo;
+                if (peakThrowVelo.Z() > launchVelo.Z()) {
+                    launchVelo = peakThrowVelo;
+                }
+
+                // Don't boost if it's just a gentle release. Threshold 200.0 is reasonable.
+                if (launchVelo.Length() > 200.0f) {
+                    // Clamp Vertical Fling
+                    float finalZ = launchVelo.Z();
+                    if (finalZ > settings.fMaxFlingVelocity) finalZ = settings.fMaxFlingVelocity;
+
+                    cmd.launch = true;
+                    cmd.launchVelocity = launchVelo.WithZ(finalZ);
+                }
+
+                // Reset trackers
+                peakThrowVelo = {};
+            }
+        }
+    }
+
+    wasClimbing = isClimbing;
+    lastSetVelocity = cmd.setVelocity;
+    lastVelocity = cmd.velocity;
+    return cmd;
+}
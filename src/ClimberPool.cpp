@@ -0,0 +1,72 @@
+#include "ClimberPool.h"
+
+using namespace Climb;
+
+bool ControllerMap::Insert(std::uintptr_t controller, int slot) {
+    if (controller == 0 || (controller & 1) || (controller & ~kKeyMask) || slot < 0) return false;
+    const std::uint64_t entry = controller | (static_cast<std::uint64_t>(slot) << kSlotShift);
+    auto& table = tables[generation.load(std::memory_order_relaxed) & 1];
+
+    // Already present: update in place
+    int reuse = -1;
+    for (std::uint32_t i = Home(controller), n = 0; n < kCapacity; i = (i + 1) & kMask, n++) {
+        const auto e = table[i].load(std::memory_order_relaxed);
+        if ((e & kKeyMask) == controller) {
+            table[i].store(entry, std::memory_order_release);
+            return true;
+        }
+        if (e == kTombstone && reuse < 0) reuse = static_cast<int>(i);
+        if (e == kEmpty) {
+            if (reuse < 0) reuse = static_cast<int>(i);
+            break;
+        }
+    }
+    if (reuse < 0 || live + 1 > kCapacity / 2) return false;
+
+    if (table[reuse].load(std::memory_order_relaxed) == kTombstone) tombstones--;
+    table[reuse].store(entry, std::memory_order_release);
+    live++;
+    return true;
+}
+
+void ControllerMap::Erase(std::uintptr_t controller) {
+    auto& table = tables[generation.load(std::memory_order_relaxed) & 1];
+    for (std::uint32_t i = Home(controller), n = 0; n < kCapacity; i = (i + 1) & kMask, n++) {
+        const auto e = table[i].load(std::memory_order_relaxed);
+        if (e == kEmpty) return;
+        if ((e & kKeyMask) == controller) {
+            table[i].store(kTombstone, std::memory_order_release);
+            live--;
+            tombstones++;
+            break;
+        }
+    }
+    // Long tombstone runs make misses probe further; start over in the other table
+    if (tombstones > kCapacity / 4) Rebuild();
+}
+
+void ControllerMap::Clear() {
+    auto& table = tables[generation.load(std::memory_order_relaxed) & 1];
+    for (auto& e : table) e.store(kEmpty, std::memory_order_release);
+    live = 0;
+    tombstones = 0;
+}
+
+// The old table is left as it was, so readers already in it finish on a consistent (if stale)
+// copy. Stores are release so a reader that sees any of them in the next rebuild also sees the
+// generation that came before it, and retries.
+void ControllerMap::Rebuild() {
+    const auto gen = generation.load(std::memory_order_relaxed);
+    auto& src = tables[gen & 1];
+    auto& dst = tables[(gen + 1) & 1];
+    for (auto& e : dst) e.store(kEmpty, std::memory_order_release);
+    for (const auto& e : src) {
+        const auto entry = e.load(std::memory_order_relaxed);
+        if (entry == kEmpty || entry == kTombstone) continue;
+        std::uint32_t i = Home(static_cast<std::uintptr_t>(entry & kKeyMask));
+        while (dst[i].load(std::memory_order_relaxed) != kEmpty) i = (i + 1) & kMask;
+        dst[i].store(entry, std::memory_order_release);
+    }
+    tombstones = 0;
+    generation.store(gen + 1, std::memory_order_release);
+}
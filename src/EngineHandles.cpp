@@ -0,0 +1,65 @@
+#include "EngineHandles.h"
+
+using namespace std::literals;
+
+void EngineHandles::Refresh(RE::PlayerCharacter* player) {
+    if (!player) {
+        Invalidate();
+        return;
+    }
+
+    // Also retry while the VR hand nodes are missing (they can attach a few frames after the 3D)
+    if (player->Get3D() != root.get() || !vrHand[0] || !vrHand[1]) ResolveNodes(player);
+
+    // Likewise while the cell has no Havok world yet (it can still be attaching on the first frame)
+    auto currentCell = player->GetParentCell();
+    if (currentCell != cell || !cellResolved || (cell && !world)) ResolveWorld(currentCell);
+}
+
+void EngineHandles::Invalidate() {
+    root.reset();
+    vrData = nullptr;
+    vrHand[0] = vrHand[1] = nullptr;
+    skeletonHand[0] = skeletonHand[1] = nullptr;
+    cell = nullptr;
+    world = nullptr;
+    cellResolved = false;
+    nodeGeneration++;
+    cellGeneration++;
+}
+
+// Called again every frame while a VR hand is missing, so the generation only moves when a
+// pointer actually changed, and the by-name skeleton lookup only runs for a new root.
+void EngineHandles::ResolveNodes(RE::PlayerCharacter* player) {
+    const auto newRoot = player->Get3D();
+    const bool rootChanged = newRoot != root.get();
+    const RE::NiNode* oldHand[2] = {vrHand[0], vrHand[1]};
+
+    if (rootChanged) root.reset(newRoot);
+    vrData = root ? player->GetVRNodeData() : nullptr;
+    vrHand[0] = vrData ? vrData->NPCLHnd.get() : nullptr;
+    vrHand[1] = vrData ? vrData->NPCRHnd.get() : nullptr;
+
+    if (rootChanged) {
+        skeletonHand[0] = skeletonHand[1] = nullptr;
+        if (auto actorRoot = root ? netimmerse_cast<RE::BSFadeNode*>(root.get()) : nullptr) {
+            skeletonHand[0] = actorRoot->GetObjectByName("NPC L Hand [LHnd]"sv);
+            skeletonHand[1] = actorRoot->GetObjectByName("NPC R Hand [RHnd]"sv);
+        }
+    }
+
+    if (rootChanged || vrHand[0] != oldHand[0] || vrHand[1] != oldHand[1]) nodeGeneration++;
+}
+
+void EngineHandles::ResolveWorld(RE::TESObjectCELL* currentCell) {
+    const auto oldCell = cell;
+    const auto oldWorld = world;
+    cell = currentCell;
+    cellResolved = true;
+
+    world = nullptr;
+    if (cell) {
+        if (auto bhk = cell->GetbhkWorld()) world = bhk->GetWorld1();
+    }
+    if (cell != oldCell || world != oldWorld) cellGeneration++;
+}
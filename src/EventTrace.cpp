@@ -0,0 +1,162 @@
+#include "EventTrace.h"
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <unistd.h>
+    #include <sys/syscall.h>
+#endif
+
+using namespace Climb;
+
+namespace {
+    std::uint32_t CurrentThreadID() {
+#ifdef _WIN32
+        return static_cast<std::uint32_t>(GetCurrentThreadId());
+#else
+        return static_cast<std::uint32_t>(syscall(SYS_gettid));
+#endif
+    }
+}
+
+EventTracer& EventTracer::Get() {
+    static EventTracer tracer;
+    return tracer;
+}
+
+bool EventTracer::Start(const char* path, std::chrono::milliseconds flushInterval) {
+    Stop();
+    std::lock_guard lock(fileLock);
+    file = std::fopen(path, "wb");
+    if (!file) return false;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    firstEvent = true;
+    written = 0;
+
+    // Forget whatever was left in the rings from an earlier session
+    for (int i = 0; i < ringCount.load(std::memory_order_acquire); i++) {
+        auto ring = rings[i].load(std::memory_order_acquire);
+        ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+        ring->dropped = 0;
+    }
+    unregistered = 0;
+
+    origin = std::chrono::steady_clock::now();
+    enabled.store(true, std::memory_order_release);
+    flusher = std::jthread([this, flushInterval](std::stop_token stop) { FlushLoop(stop, flushInterval); });
+    return true;
+}
+
+void EventTracer::Stop() {
+    if (!enabled.exchange(false)) return;
+    if (flusher.joinable()) {
+        flusher.request_stop();
+        flusher.join();
+    }
+    Drain();
+
+    std::lock_guard lock(fileLock);
+    if (!file) return;
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+    file = nullptr;
+}
+
+std::uint64_t EventTracer::Dropped() const {
+    std::uint64_t total = unregistered.load(std::memory_order_relaxed);
+    for (int i = 0; i < ringCount.load(std::memory_order_acquire); i++) {
+        total += rings[i].load(std::memory_order_acquire)->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::uint64_t EventTracer::SinceStart(std::chrono::steady_clock::time_point t) const {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t - origin).count();
+    return ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+}
+
+void EventTracer::Span(const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end,
+                       std::uint32_t arg) {
+    if (!Enabled()) return;
+    const auto ts = SinceStart(begin);
+    const auto endNs = SinceStart(end);
+    Push({name, ts, endNs > ts ? endNs - ts : 0, arg, 'X'});
+}
+
+void EventTracer::Instant(const char* name, std::uint32_t arg) {
+    if (!Enabled()) return;
+    Push({name, SinceStart(std::chrono::steady_clock::now()), 0, arg, 'i'});
+}
+
+void EventTracer::Push(const TraceEvent& ev) {
+    thread_local ThreadRing* ring = nullptr;
+    thread_local bool registered = false;
+    if (!registered) {
+        ring = RegisterThread();
+        registered = true;
+    }
+    if (!ring) {
+        unregistered.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Single producer: only this thread writes head
+    const auto head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= kRingEvents) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->events[head & (kRingEvents - 1)] = ev;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+// Once per thread, on its first event
+EventTracer::ThreadRing* EventTracer::RegisterThread() {
+    std::lock_guard lock(registerLock);
+    const int slot = ringCount.load(std::memory_order_relaxed);
+    if (slot >= kMaxThreads) return nullptr;
+    auto ring = new ThreadRing;  // Kept for the life of the process; the flusher may be reading it
+    ring->tid = CurrentThreadID();
+    rings[slot].store(ring, std::memory_order_release);
+    ringCount.store(slot + 1, std::memory_order_release);
+    return ring;
+}
+
+void EventTracer::FlushLoop(std::stop_token stop, std::chrono::milliseconds interval) {
+    while (!stop.stop_requested()) {
+        Drain();
+        for (auto slept = std::chrono::milliseconds(0); slept < interval && !stop.stop_requested(); slept += std::chrono::milliseconds(10)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+void EventTracer::Drain() {
+    std::lock_guard lock(fileLock);
+    if (!file) return;
+
+    const int count = ringCount.load(std::memory_order_acquire);
+    std::uint64_t wrote = 0;
+    for (int i = 0; i < count; i++) {
+        auto ring = rings[i].load(std::memory_order_acquire);
+        const auto tail = ring->tail.load(std::memory_order_relaxed);
+        const auto head = ring->head.load(std::memory_order_acquire);
+        for (auto n = tail; n < head; n++) {
+            const auto& ev = ring->events[n & (kRingEvents - 1)];
+            std::fputs(firstEvent ? "" : ",\n", file);
+            firstEvent = false;
+            // Trace-event timestamps are microseconds
+            if (ev.phase == 'X') {
+                std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"v\":%u}}",
+                             ev.name, ring->tid, ev.tsNs / 1000.0, ev.durNs / 1000.0, ev.arg);
+            } else {
+                std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"v\":%u}}",
+                             ev.name, ring->tid, ev.tsNs / 1000.0, ev.arg);
+            }
+            wrote++;
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+    if (wrote) std::fflush(file);
+    written.fetch_add(wrote, std::memory_order_relaxed);
+}
@@ -0,0 +1,43 @@
+#include "FormClassCache.h"
+#include <algorithm>
+#include <bit>
+
+using namespace Climb;
+
+FormClassCache::FormClassCache(std::size_t initialCapacity) {
+    std::size_t cap = std::bit_ceil(initialCapacity < 16 ? std::size_t(16) : initialCapacity);
+    keys.assign(cap, 0);
+    values.assign(cap, 0);
+    mask = cap - 1;
+}
+
+void FormClassCache::Insert(std::uint32_t formID, std::uint8_t cls) {
+    if (formID == 0) return;
+    // Keep the load factor under 1/2 so lookups stay at about one probe
+    if ((count + 1) * 2 > keys.size()) Grow();
+
+    std::size_t idx = IndexOf(formID);
+    while (keys[idx] != 0 && keys[idx] != formID) idx = (idx + 1) & mask;
+    if (keys[idx] == 0) count++;
+    keys[idx] = formID;
+    values[idx] = cls;
+}
+
+void FormClassCache::Clear() {
+    std::fill(keys.begin(), keys.end(), 0u);
+    count = 0;
+}
+
+void FormClassCache::Grow() {
+    std::vector<std::uint32_t> oldKeys = std::move(keys);
+    std::vector<std::uint8_t> oldValues = std::move(values);
+
+    const std::size_t cap = oldKeys.size() * 2;
+    keys.assign(cap, 0);
+    values.assign(cap, 0);
+    mask = cap - 1;
+    count = 0;
+    for (std::size_t i = 0; i < oldKeys.size(); i++) {
+        if (oldKeys[i] != 0) Insert(oldKeys[i], oldValues[i]);
+    }
+}
@@ -0,0 +1,237 @@
+#include "FrameTrace.h"
+#include <cstring>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace Climb;
+
+namespace {
+    constexpr std::size_t kFlushRecords = 512;
+
+    void Store(float (&dst)[3], const Vec3& v) {
+        dst[0] = v.x;
+        dst[1] = v.y;
+        dst[2] = v.z;
+    }
+
+    void Store(float (&dst)[3], const Vec4& v) { Store(dst, v.ToVec3()); }
+
+    Vec3 Load(const float (&src)[3]) { return {src[0], src[1], src[2]}; }
+}
+
+TraceFrame Climb::EncodeFrame(const FrameInput& in, const FrameCommand& cmd, const Vec3 relPos[2]) {
+    TraceFrame f{};
+    f.dt = in.dt;
+    f.stamina = in.stamina;
+    Store(f.charVelocity, in.charVelocity);
+    if (in.hasCharController) f.flags |= kTraceHasCharController;
+    if (cmd.setVelocity) f.flags |= kTraceSetVelocity;
+    if (cmd.launch) f.flags |= kTraceLaunch;
+    if (cmd.startedClimb) f.flags |= kTraceStartedClimb;
+
+    for (int hand = kLeft; hand <= kRight; hand++) {
+        const auto& h = in.hands[hand];
+        auto& out = f.hands[hand];
+        Store(out.relPos, relPos[hand]);
+        Store(out.pos, h.position);
+        Store(out.velocity, h.velocity);
+        Store(out.normal, h.hit.normal);
+        out.refrFormID = h.hit.refrFormID;
+        if (h.tracked) out.flags |= kTraceTracked;
+        if (h.gripping) out.flags |= kTraceGripping;
+        if (h.hasClimbingTool) out.flags |= kTraceClimbingTool;
+        if (h.hit.hit) out.flags |= kTraceHit;
+        if (h.hit.isIce) out.flags |= kTraceIce;
+    }
+
+    Store(f.outVelocity, cmd.velocity);
+    Store(f.launchVelocity, cmd.launchVelocity);
+    return f;
+}
+
+FrameInput Climb::DecodeInput(const TraceFrame& f) {
+    FrameInput in;
+    in.dt = f.dt;
+    in.stamina = f.stamina;
+    in.charVelocity = Vec4(Load(f.charVelocity));
+    in.hasCharController = f.flags & kTraceHasCharController;
+
+    for (int hand = kLeft; hand <= kRight; hand++) {
+        const auto& src = f.hands[hand];
+        auto& h = in.hands[hand];
+        h.tracked = src.flags & kTraceTracked;
+        h.gripping = src.flags & kTraceGripping;
+        h.hasClimbingTool = src.flags & kTraceClimbingTool;
+        h.position = Load(src.pos);
+        h.velocity = Load(src.velocity);
+        h.hit.hit = src.flags & kTraceHit;
+        h.hit.isIce = src.flags & kTraceIce;
+        h.hit.normal = Load(src.normal);
+        h.hit.refrFormID = src.refrFormID;
+    }
+    return in;
+}
+
+ClimbingSettings Climb::DecodeSettings(const TraceRecord& rec) {
+    ClimbingSettings s;
+    std::memcpy(&s, rec.settingsData, sizeof(s));
+    return s;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TraceWriter::Open(const char* path) {
+    Close();
+    file = std::fopen(path, "wb");
+    if (!file) return false;
+
+    TraceHeader header{};
+    std::memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+    header.version = kTraceVersion;
+    header.headerSize = sizeof(TraceHeader);
+    header.recordSize = sizeof(TraceRecord);
+    header.settingsSize = sizeof(ClimbingSettings);
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    buffer.reserve(kFlushRecords);
+    frameIndex = 0;
+    Reset(TraceResetReason::kOpened);
+    return true;
+}
+
+void TraceWriter::Close() {
+    if (!file) return;
+    Flush();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void TraceWriter::Flush() {
+    if (!file || buffer.empty()) return;
+    std::fwrite(buffer.data(), sizeof(TraceRecord), buffer.size(), file);
+    std::fflush(file);
+    buffer.clear();
+}
+
+void TraceWriter::Push(const TraceRecord& rec) {
+    buffer.push_back(rec);
+    if (buffer.size() >= kFlushRecords) Flush();
+}
+
+void TraceWriter::Reset(TraceResetReason reason) {
+    if (!file) return;
+    TraceRecord rec{};
+    rec.kind = TraceKind::kReset;
+    rec.frame = frameIndex;
+    rec.resetReason = reason;
+    Push(rec);
+    hasSettings = false;  // Each segment carries its own settings
+}
+
+void TraceWriter::Write(const FrameInput& in, const FrameCommand& cmd, const Vec3 relPos[2],
+                        const ClimbingSettings& settings) {
+    if (!file) return;
+
+    if (!hasSettings || std::memcmp(&lastSettings, &settings, sizeof(settings)) != 0) {
+        TraceRecord rec{};
+        rec.kind = TraceKind::kSettings;
+        rec.frame = frameIndex;
+        std::memcpy(rec.settingsData, &settings, sizeof(settings));
+        Push(rec);
+        lastSettings = settings;
+        hasSettings = true;
+    }
+
+    TraceRecord rec{};
+    rec.kind = TraceKind::kFrame;
+    rec.frame = frameIndex++;
+    rec.frameData = EncodeFrame(in, cmd, relPos);
+    Push(rec);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TraceReader::Open(const char* path) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fh, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(TraceHeader))) {
+        CloseHandle(fh);
+        return false;
+    }
+    HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mh) {
+        CloseHandle(fh);
+        return false;
+    }
+    void* view = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mh);
+        CloseHandle(fh);
+        return false;
+    }
+    fileHandle = fh;
+    mapHandle = mh;
+    mapping = view;
+    mappedSize = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(TraceHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    mapping = view;
+    mappedSize = static_cast<std::size_t>(st.st_size);
+#endif
+
+    const auto* header = static_cast<const TraceHeader*>(mapping);
+    // headerSize comes from the file: anything but our own would put the records out of bounds
+    if (std::memcmp(header->magic, kTraceMagic, sizeof(kTraceMagic)) != 0 || header->version < 1 || header->version > kTraceVersion ||
+        header->headerSize != sizeof(TraceHeader) || header->recordSize != sizeof(TraceRecord) ||
+        header->settingsSize != sizeof(ClimbingSettings)) {
+        Close();
+        return false;
+    }
+
+    records = reinterpret_cast<const TraceRecord*>(static_cast<const char*>(mapping) + header->headerSize);
+    // A trace cut short by a crash simply ends at its last complete record.
+    count = (mappedSize - header->headerSize) / sizeof(TraceRecord);
+    return true;
+}
+
+void TraceReader::Close() {
+    if (mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapping);
+        CloseHandle(static_cast<HANDLE>(mapHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mapHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        ::munmap(mapping, mappedSize);
+#endif
+    }
+    mapping = nullptr;
+    mappedSize = 0;
+    records = nullptr;
+    count = 0;
+}
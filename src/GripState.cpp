@@ -0,0 +1,50 @@
+#include "GripState.h"
+
+using namespace Climb;
+
+void GripDecoder::SetDefaults() {
+    ClearDevices();
+    // Device 1: Standard Left Controller
+    // Device 6: Detected as Left in some VR configs (Fix for inverted controls)
+    SetDevice(1, 0);
+    SetDevice(6, 0);
+    // Device 2: Standard Right Controller
+    // Device 5: Detected as Right in some VR configs (Fix for inverted controls)
+    SetDevice(2, 1);
+    SetDevice(5, 1);
+    gripID = 2;
+}
+
+void GripDecoder::ClearDevices() {
+    for (auto& h : hands) h = -1;
+}
+
+void GripDecoder::SetDevice(int device, int hand) {
+    if (device < 0 || device >= kMaxDevices) return;
+    hands[device] = static_cast<std::int8_t>(hand < 0 ? -1 : (hand ? 1 : 0));
+}
+
+bool GripDecoder::SetDeviceList(std::string_view list, int hand) {
+    bool ok = true;
+    while (!list.empty()) {
+        auto comma = list.find(',');
+        auto item = list.substr(0, comma);
+        int device = 0;
+        bool digits = false;
+        for (char c : item) {
+            if (c >= '0' && c <= '9') {
+                device = device * 10 + (c - '0');
+                digits = true;
+                if (device >= kMaxDevices) break;
+            } else if (c != ' ' && c != '\t') {
+                digits = false;
+                break;
+            }
+        }
+        if (digits && device < kMaxDevices) SetDevice(device, hand);
+        else if (item.find_first_not_of(" \t") != std::string_view::npos) ok = false;
+        if (comma == std::string_view::npos) break;
+        list.remove_prefix(comma + 1);
+    }
+    return ok;
+}
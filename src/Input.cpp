@@ -1,4 +1,5 @@
 #include "Input.h"
+#include "settings.h"
 
 using namespace RE;
 
@@ -18,15 +19,22 @@ void InputManager::Register() {
 }
 
 bool InputManager::IsLeftGripPressed() {
-    auto now = std::chrono::steady_clock::now();
-    auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(now - _lastLeftPress).count();
-    return dur < 100; // 100ms timeout
+    return _leftGrip.Poll(_leftSeenPresses);
 }
 
 bool InputManager::IsRightGripPressed() {
-     auto now = std::chrono::steady_clock::now();
-    auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(now - _lastRightPress).count();
-    return dur < 100; 
+    return _rightGrip.Poll(_rightSeenPresses);
+}
+
+std::int64_t InputManager::GripPressedAt(bool isLeft) const {
+    return isLeft ? _leftGrip.PressedAt() : _rightGrip.PressedAt();
+}
+
+void InputManager::ResetGrips() {
+    _leftGrip.Reset();
+    _rightGrip.Reset();
+    _leftGrip.Poll(_leftSeenPresses);  // Drop presses from before the reset
+    _rightGrip.Poll(_rightSeenPresses);
 }
 
 bool InputManager::IsSneaking() {
@@ -55,30 +63,16 @@ RE::BSEventNotifyControl InputManager::ProcessEvent(InputEvent* const* a_event,
              }
         }
 
-        auto device = buttonEvent->GetDevice();
-        auto idCode = buttonEvent->GetIDCode();
+        // Grip button: device -> hand through the [Input] decode table
+        Climb::GripEvent grip{(int)buttonEvent->GetDevice(), buttonEvent->GetIDCode(), buttonEvent->Value()};
+        int hand = Settings::GetSingleton()->Current().gripDecoder.Decode(grip);
+        if (hand < 0) continue;
 
-        // Check for Grip Button (ID 2).
-        // We ignore IDs 33/34 to prevent duplicate event processing.
-        bool isGripID = (idCode == 2); 
-        
-        if (isGripID) {
-             int devInt = (int)device;
-             
-             // Left Hand Detection
-             // Device 1: Standard Left Controller
-             // Device 6: Detected as Left in some VR configs (Fix for inverted controls)
-             if (devInt == 1 || devInt == 6) {
-                 _lastLeftPress = std::chrono::steady_clock::now();
-             }
-             
-             // Right Hand Detection
-             // Device 2: Standard Right Controller
-             // Device 5: Detected as Right in some VR configs (Fix for inverted controls)
-             if (devInt == 2 || devInt == 5) {
-                 _lastRightPress = std::chrono::steady_clock::now();
-             }
-        }
+        // Press/release edges: Value() > 0 while held, 0 on the release (IsUp) event
+        bool pressed = grip.Pressed();
+        auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch()).count();
+        (hand == 0 ? _leftGrip : _rightGrip).Apply(pressed, now);
     }
 
     return BSEventNotifyControl::kContinue;
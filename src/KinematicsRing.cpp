@@ -0,0 +1,122 @@
+#include "KinematicsRing.h"
+#include <bit>
+
+using namespace Climb;
+
+std::uint32_t KinematicsRing::Count() const { return static_cast<std::uint32_t>(std::popcount(valid)); }
+
+Vec3 KinematicsRing::Latest() const {
+    if (Empty()) return {};
+    const std::uint32_t i = (head - 1) & kMask;
+    return {x[i], y[i], z[i]};
+}
+
+double KinematicsRing::LatestTime() const { return Empty() ? 0.0 : t[(head - 1) & kMask]; }
+
+bool KinematicsRing::PositionAt(double time, Vec3& out) const {
+    if (Empty() || time > t[(head - 1) & kMask]) return false;
+    std::uint32_t newer = (head - 1) & kMask;
+    for (std::uint32_t k = 1; k <= kCapacity; k++) {
+        const std::uint32_t i = (head - k) & kMask;
+        if (!(valid >> i & 1) || t[i] > t[newer]) return false;  // Ran off the history (or the clock went back)
+        if (t[i] <= time) {
+            const double span = t[newer] - t[i];
+            const float u = span > 0.0 ? static_cast<float>((time - t[i]) / span) : 0.0f;
+            out = Vec3(x[i], y[i], z[i]) + (Vec3(x[newer], y[newer], z[newer]) - Vec3(x[i], y[i], z[i])) * u;
+            return true;
+        }
+        newer = i;
+    }
+    return false;
+}
+
+Vec3 Climb::PositionAtTime(const Vec3& current, const KinematicsRing& hand, const KinematicsRing& body, double time,
+                           double maxAge) {
+    if (time < hand.LatestTime() - maxAge) return current;
+    Vec3 handAt, bodyAt;
+    if (!hand.PositionAt(time, handAt) || !body.PositionAt(time, bodyAt)) return current;
+    return current - ((hand.Latest() + body.Latest()) - (handAt + bodyAt));
+}
+
+std::uint32_t KinematicsRing::Gather(float window, std::uint32_t out[kCapacity]) const {
+    if (Empty()) return 0;
+    const double newest = t[(head - 1) & kMask];
+    // Small slack so a window of exactly N frame times keeps N + 1 samples despite clock jitter
+    const double oldest = newest - window * 1.05;
+    std::uint32_t n = 0;
+    for (std::uint32_t k = 1; k <= kCapacity; k++) {
+        const std::uint32_t i = (head - k) & kMask;
+        if (!(valid >> i & 1) || t[i] < oldest || t[i] > newest) break;
+        out[n++] = i;
+    }
+    return n;
+}
+
+Vec3 KinematicsRing::VelocityLeastSquares(float window) const {
+    std::uint32_t idx[kCapacity];
+    const std::uint32_t n = Gather(window, idx);
+    if (n < 2) return {};
+
+    const double newest = t[idx[0]];
+    double mt = 0.0;
+    Vec3 mp;
+    for (std::uint32_t k = 0; k < n; k++) {
+        mt += t[idx[k]] - newest;
+        mp += Vec3(x[idx[k]], y[idx[k]], z[idx[k]]);
+    }
+    mt /= n;
+    mp = mp / static_cast<float>(n);
+
+    double stt = 0.0, stx = 0.0, sty = 0.0, stz = 0.0;
+    for (std::uint32_t k = 0; k < n; k++) {
+        const std::uint32_t i = idx[k];
+        const double dt = t[i] - newest - mt;
+        stt += dt * dt;
+        stx += dt * (x[i] - mp.x);
+        sty += dt * (y[i] - mp.y);
+        stz += dt * (z[i] - mp.z);
+    }
+    if (stt <= 0.0) return {};
+    return {static_cast<float>(stx / stt), static_cast<float>(sty / stt), static_cast<float>(stz / stt)};
+}
+
+Vec3 KinematicsRing::VelocitySavitzkyGolay(float window) const {
+    std::uint32_t idx[kCapacity];
+    const std::uint32_t n = Gather(window, idx);
+    if (n < 4) return VelocityLeastSquares(window);
+
+    // p(u) = a + b u + c u^2 with u = (t - newest) / window, so the sums stay near 1
+    const double newest = t[idx[0]];
+    const double scale = window > 0.0f ? 1.0 / window : 1.0;
+    double s[5]{};
+    double py[3][3]{};  // [axis][power]
+    for (std::uint32_t k = 0; k < n; k++) {
+        const std::uint32_t i = idx[k];
+        const double u = (t[i] - newest) * scale;
+        const double u2 = u * u;
+        s[0] += 1.0;
+        s[1] += u;
+        s[2] += u2;
+        s[3] += u2 * u;
+        s[4] += u2 * u2;
+        const double v[3] = {x[i], y[i], z[i]};
+        for (int a = 0; a < 3; a++) {
+            py[a][0] += v[a];
+            py[a][1] += v[a] * u;
+            py[a][2] += v[a] * u2;
+        }
+    }
+
+    // Cramer's rule for b in the 3x3 normal equations
+    const double det = s[0] * (s[2] * s[4] - s[3] * s[3]) - s[1] * (s[1] * s[4] - s[3] * s[2]) +
+                       s[2] * (s[1] * s[3] - s[2] * s[2]);
+    if (det <= 1e-12) return VelocityLeastSquares(window);
+
+    float out[3];
+    for (int a = 0; a < 3; a++) {
+        const double detB = s[0] * (py[a][1] * s[4] - s[3] * py[a][2]) - py[a][0] * (s[1] * s[4] - s[3] * s[2]) +
+                            s[2] * (s[1] * py[a][2] - py[a][1] * s[2]);
+        out[a] = static_cast<float>(detB / det * scale);
+    }
+    return {out[0], out[1], out[2]};
+}
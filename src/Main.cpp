@@ -2,6 +2,7 @@
 #include "OnFrame.h"
 #include "settings.h"
 #include "Input.h"
+#include "Sound.h"
 
 using namespace SKSE;
 using namespace SKSE::log;
@@ -10,6 +11,8 @@ using namespace SKSE::stl;
 namespace {
     /**
      * Setup logging.
+     * Lines are formatted on the calling thread and written by spdlog's worker thread. The queue is
+     * bounded; when a burst fills it the oldest lines are dropped instead of blocking the game.
      */
     void InitializeLogging() {
         auto path = log_directory();
@@ -19,18 +22,20 @@ namespace {
         *path /= PluginDeclaration::GetSingleton()->GetName();
         *path += L".log";
 
-        std::shared_ptr<spdlog::logger> log;
+        spdlog::sink_ptr sink;
         if (IsDebuggerPresent()) {
-            log = std::make_shared<spdlog::logger>("Global", std::make_shared<spdlog::sinks::msvc_sink_mt>());
+            sink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
         } else {
-            log = std::make_shared<spdlog::logger>(
-                "Global", std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true));
+            sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
         }
+        spdlog::init_thread_pool(8192, 1);
+        auto log = std::make_shared<spdlog::async_logger>("Global", std::move(sink), spdlog::thread_pool(),
+                                                          spdlog::async_overflow_policy::overrun_oldest);
 
-        const auto level = spdlog::level::info;
-
-        log->set_level(level);
-        log->flush_on(level);
+        // [Debug] sLogLevel replaces this once the settings load (Settings::Update)
+        log->set_level(spdlog::level::info);
+        log->flush_on(spdlog::level::warn);  // The worker flushes; info lines reach the disk within a second
+        spdlog::flush_every(std::chrono::seconds(1));
 
         spdlog::set_default_logger(std::move(log));
         spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] [%t] [%s:%#] %v");
@@ -45,24 +50,53 @@ namespace {
         log::trace("Hooks initialized.");
     }
 
-    class HotReloadHandler : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
+    void ApplyPlayerRace() {
+        if (auto player = RE::PlayerCharacter::GetSingleton()) {
+            Settings::GetSingleton()->ApplyRace(player->GetRace());
+        }
+    }
+
+    class MenuHandler : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
     public:
-        static HotReloadHandler* GetSingleton() {
-            static HotReloadHandler singleton;
+        static MenuHandler* GetSingleton() {
+            static MenuHandler singleton;
             return &singleton;
         }
 
         RE::BSEventNotifyControl ProcessEvent(const RE::MenuOpenCloseEvent* a_event, RE::BSTEventSource<RE::MenuOpenCloseEvent>*) override {
-            // Reload on Console close or Journal Menu close (Pause menu)
-            if (!a_event->opening && (a_event->menuName == "Console" || a_event->menuName == "Journal Menu")) {
-                log::info("Menu closed. Reloading Settings from INI...");
-                try {
-                    Settings::GetSingleton()->Load();
-                    log::info("Settings reloaded successfully.");
-                } catch (...) {
-                    log::error("Failed to reload settings.");
+            // Character creation can change the race without a SwitchRace event
+            if (!a_event->opening && a_event->menuName == RE::RaceSexMenu::MENU_NAME) {
+                ApplyPlayerRace();
+            }
+            // A pausing menu takes the grip release event: let go rather than stay gripped after it
+            if (a_event->opening) {
+                auto ui = RE::UI::GetSingleton();
+                if (auto menu = ui ? ui->GetMenu(a_event->menuName) : nullptr; menu && menu->PausesGame()) {
+                    InputManager::GetSingleton()->ResetGrips();
                 }
             }
+#ifdef FREECLIMB_PROFILE
+            // On-demand stage timing report: open the console
+            if (a_event->opening && a_event->menuName == RE::Console::MENU_NAME) {
+                LogStageTimings(true);
+            }
+#endif
+            return RE::BSEventNotifyControl::kContinue;
+        }
+    };
+
+    // Race profile switching: transformations (werewolf, vampire lord) and any other SwitchRace
+    class RaceSwitchHandler : public RE::BSTEventSink<RE::TESSwitchRaceCompleteEvent> {
+    public:
+        static RaceSwitchHandler* GetSingleton() {
+            static RaceSwitchHandler singleton;
+            return &singleton;
+        }
+
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESSwitchRaceCompleteEvent* a_event, RE::BSTEventSource<RE::TESSwitchRaceCompleteEvent>*) override {
+            if (a_event && a_event->subject && a_event->subject->IsPlayerRef()) {
+                ApplyPlayerRace();
+            }
             return RE::BSEventNotifyControl::kContinue;
         }
     };
@@ -70,17 +104,28 @@ namespace {
     void MessageHandler(SKSE::MessagingInterface::Message* a_msg) {
         switch (a_msg->type) {
             case SKSE::MessagingInterface::kDataLoaded: {
-                log::info("kDataLoaded - Registering Input & Hot Reload"); 
+                log::info("kDataLoaded - Registering Input & Race Events"); 
                 InputManager::GetSingleton()->Register(); // Register here!
+                ResetSurfaceClassCache();
+                Sound::ResolveSounds();
+                ResolveHapticBackend();
+                Settings::GetSingleton()->OnDataLoaded(); // Resolve [Race_*] sections now that races exist
+                if (auto events = RE::ScriptEventSourceHolder::GetSingleton()) {
+                    events->AddEventSink<RE::TESSwitchRaceCompleteEvent>(RaceSwitchHandler::GetSingleton());
+                }
                 
                 auto ui = RE::UI::GetSingleton();
                 if (ui) {
-                    ui->AddEventSink<RE::MenuOpenCloseEvent>(HotReloadHandler::GetSingleton());
+                    ui->AddEventSink<RE::MenuOpenCloseEvent>(MenuHandler::GetSingleton());
                 }
             } break;
             case SKSE::MessagingInterface::kPreLoadGame: {
                 ZacOnFrame::CleanBeforeLoad();
             } break;
+            case SKSE::MessagingInterface::kPostLoadGame:
+            case SKSE::MessagingInterface::kNewGame: {
+                ApplyPlayerRace();
+            } break;
         }
     }
 }  // namespace
@@ -97,11 +142,8 @@ SKSEPluginLoad(const LoadInterface* skse) {
 
     Init(skse);
 
-    try {
-        Settings::GetSingleton()->Load();
-    } catch (...) {
-        logger::error("Exception caught when loading settings! Default settings will be used");
-    }
+    // Loaded (and hot-reloaded on file change) in the background; built-in defaults until then
+    Settings::GetSingleton()->StartWatcher();
 
     InitializeHooks();
     SKSE::GetMessagingInterface()->RegisterListener(MessageHandler);
@@ -0,0 +1,144 @@
+#include "MaterialMatcher.h"
+#include <queue>
+
+using namespace Climb;
+
+namespace {
+    // Priority order when several materials match one name
+    constexpr Material kRankOrder[] = {Material::kWood, Material::kSnow, Material::kMetal, Material::kDirt, Material::kStone};
+}
+
+int MaterialMatcher::Rank(Material m) {
+    for (int i = 0; i < static_cast<int>(std::size(kRankOrder)); i++) {
+        if (kRankOrder[i] == m) return i;
+    }
+    return static_cast<int>(std::size(kRankOrder));
+}
+
+const char* MaterialMatcher::MaterialName(Material material) {
+    switch (material) {
+        case Material::kWood: return "Wood";
+        case Material::kSnow: return "Snow";
+        case Material::kMetal: return "Metal";
+        case Material::kDirt: return "Dirt";
+        default: return "Stone";
+    }
+}
+
+const char* MaterialMatcher::DefaultPatterns(Material material) {
+    switch (material) {
+        case Material::kWood: return "Wood, Tree, Log, Plank";
+        case Material::kSnow: return "Ice, Snow, Frozen";
+        case Material::kMetal: return "Metal, Iron, Steel, Dwarven";
+        case Material::kDirt: return "Dirt, Soil, Grass";
+        default: return "";
+    }
+}
+
+MaterialMatcher MaterialMatcher::Defaults() {
+    MaterialMatcher m;
+    for (auto mat : kRankOrder) m.AddPatternList(DefaultPatterns(mat), mat);
+    m.Build();
+    return m;
+}
+
+void MaterialMatcher::AddPattern(std::string_view pattern, Material material) {
+    if (pattern.empty()) return;
+    patterns.push_back({std::string(pattern), material});
+    built = false;
+}
+
+void MaterialMatcher::AddPatternList(std::string_view list, Material material) {
+    while (!list.empty()) {
+        auto comma = list.find(',');
+        auto item = list.substr(0, comma);
+        while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) item.remove_prefix(1);
+        while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) item.remove_suffix(1);
+        AddPattern(item, material);
+        if (comma == std::string_view::npos) break;
+        list.remove_prefix(comma + 1);
+    }
+}
+
+void MaterialMatcher::Clear() {
+    patterns.clear();
+    next.clear();
+    best.clear();
+    built = false;
+}
+
+void MaterialMatcher::Build() {
+    // Compress the alphabet to the bytes that appear in patterns (class 0 = anything else)
+    std::fill(std::begin(byteClass), std::end(byteClass), std::uint8_t(0));
+    classCount = 1;
+    for (const auto& p : patterns) {
+        for (unsigned char c : p.text) {
+            if (!byteClass[c]) byteClass[c] = static_cast<std::uint8_t>(classCount++);
+        }
+    }
+
+    // Trie
+    std::vector<std::int32_t> trie(static_cast<std::size_t>(classCount), -1);
+    best.assign(1, -1);
+    for (const auto& p : patterns) {
+        std::size_t node = 0;
+        for (unsigned char c : p.text) {
+            auto& slot = trie[node * classCount + byteClass[c]];
+            if (slot < 0) {
+                slot = static_cast<std::int32_t>(best.size());
+                best.push_back(-1);
+                trie.resize(trie.size() + classCount, -1);
+            }
+            node = static_cast<std::size_t>(trie[node * classCount + byteClass[c]]);
+        }
+        std::int8_t rank = static_cast<std::int8_t>(Rank(p.material));
+        if (best[node] < 0 || rank < best[node]) best[node] = rank;
+    }
+
+    // Breadth-first failure links, folded into a full transition table
+    const std::size_t nodes = best.size();
+    next.assign(nodes * classCount, 0);
+    std::vector<std::size_t> fail(nodes, 0);
+    std::queue<std::size_t> queue;
+    for (int c = 0; c < classCount; c++) {
+        auto child = trie[c];
+        if (child > 0) {
+            next[c] = static_cast<std::uint32_t>(child);
+            queue.push(static_cast<std::size_t>(child));
+        }
+    }
+    while (!queue.empty()) {
+        auto node = queue.front();
+        queue.pop();
+        auto f = fail[node];
+        if (best[f] >= 0 && (best[node] < 0 || best[f] < best[node])) best[node] = best[f];
+        for (int c = 0; c < classCount; c++) {
+            auto child = trie[node * classCount + c];
+            if (child > 0) {
+                fail[child] = next[f * classCount + c];
+                next[node * classCount + c] = static_cast<std::uint32_t>(child);
+                queue.push(static_cast<std::size_t>(child));
+            } else {
+                next[node * classCount + c] = next[f * classCount + c];
+            }
+        }
+    }
+    built = true;
+}
+
+bool MaterialMatcher::Match(std::string_view text, Material& out) const {
+    if (!built || next.empty()) return false;
+    std::size_t state = 0;
+    std::int8_t found = -1;
+    for (unsigned char c : text) {
+        state = next[state * classCount + byteClass[c]];
+        const auto b = best[state];
+        if (b >= 0 && (found < 0 || b < found)) {
+            found = b;
+            if (found == 0) break;  // Nothing outranks the first material
+        }
+    }
+    if (found < 0) return false;
+    out = found < static_cast<int>(std::size(kRankOrder)) ? kRankOrder[found] : Material::kStone;
+    return true;
+}
@@ -0,0 +1,35 @@
+#include "MotionFilter.h"
+#include <cmath>
+#include <numbers>
+
+using namespace Climb;
+
+namespace {
+    // Low-pass smoothing factor for a cutoff frequency (Hz) over dt seconds
+    float CutoffAlpha(float cutoff, float dt) {
+        const float tau = 1.0f / (2.0f * std::numbers::pi_v<float> * cutoff);
+        return 1.0f / (1.0f + tau / dt);
+    }
+}
+
+float Climb::ExpAlpha(float alphaAt90, float dt) {
+    if (alphaAt90 >= 1.0f) return 1.0f;
+    if (alphaAt90 <= 0.0f || dt <= 0.0f) return 0.0f;
+    return 1.0f - std::pow(1.0f - alphaAt90, dt * kMotionReferenceHz);
+}
+
+Vec3 OneEuroFilter::Filter(const Vec3& value, float dt, const Params& params) {
+    if (!primed || dt <= 0.0f) {
+        if (!primed) Reset(value);
+        return x;
+    }
+
+    // Smoothed rate of change drives the cutoff
+    const Vec3 rawDx = (value - x) / dt;
+    dx += (rawDx - dx) * CutoffAlpha(params.dCutoff, dt);
+
+    const float minCutoff = params.minCutoff > 0.01f ? params.minCutoff : 0.01f;
+    const float cutoff = minCutoff + params.beta * dx.Length();
+    x += (value - x) * CutoffAlpha(cutoff, dt);
+    return x;
+}
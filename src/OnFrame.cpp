@@ -2,8 +2,9 @@
 #include "OnFrame.h"
 #include "Sound.h"
 #include <chrono>
-#include <chrono>
 #include "Input.h"
+#include "FrameTrace.h"
+#include "StageTimer.h"
 
 using namespace SKSE;
 using namespace SKSE::log;
@@ -23,64 +24,51 @@ void ZacOnFrame::InstallFrameHook() {
     _SetVelocity = ProxyVTable.write_vfunc(0x07, ZacOnFrame::HookSetVelocity);
 }
 
-// Hook to override player velocity
-void ZacOnFrame::HookSetVelocity(RE::bhkCharProxyController* controller, const RE::hkVector4& a_velocity) {
-    if (!Settings::GetSingleton()->activeSettings.bEnableWholeMod) {
-        _SetVelocity(controller, a_velocity);
-        return;
-    }
+// A climb velocity older than this is not applied (ClimbMain refreshes it every frame)
+constexpr std::int64_t kMaxCommandAgeNs = 250'000'000;
 
-    auto& playerSt = PlayerState::GetSingleton();
-    if (!playerSt.player || !playerSt.player->Is3DLoaded()) {
+// Hook to override climbing actors' velocity. It runs for every proxy-controlled character, so
+// a controller that is not in the climber pool costs one lookup before it is passed through.
+void ZacOnFrame::HookSetVelocity(RE::bhkCharProxyController* controller, const RE::hkVector4& a_velocity) {
+    CLIMB_PROFILE_STAGE(kSetVelocity);
+    auto& climbers = PlayerState::climbers;
+    auto charController = static_cast<RE::bhkCharacterController*>(controller);
+    const int slot = climbers.Find(ControllerKey(charController));
+    if (slot < 0) {
         _SetVelocity(controller, a_velocity);
         return;
     }
 
-    // Usually jumpHeight is used to detect jump state in havok proxy
-    // but specific struct members might vary. Assuming direct access works (SKSE dependent)
-    // Actually, let's keep it simple.
-    
-    /* REMOVED: Allow climbing in water */
-
-    // Priority: If Climbing (setVelocity is true), override everything immediately.
+    // Priority: If Climbing, override everything immediately.
     // This allows catching ledges mid-jump without delay.
-    if (playerSt.setVelocity) {
-        // ... (rest is handled later, handled in original code?)
-        // Wait, HookSetVelocity usually calls _SetVelocity OR suppresses it.
-        // We need to see the rest of the function.
-        // I will just fix the top part.
+    if (const auto cmd = climbers.command[slot].Read(); cmd.active) {
+        const auto now = Climb::LogRateLimiter::NowNs();
+        if (cmd.IsFresh(now, kMaxCommandAgeNs)) {
+            _SetVelocity(controller, ToHkVector4(cmd.velocity));
+            return;
+        }
+        // ClimbMain stopped refreshing it (menu, 3D unloaded): let the game move the actor again
+        CLIMB_LOG_EVERY(debug, 5.0, "Ignoring climb velocity from frame {} ({:.0f} ms old)", cmd.frame,
+                        (now - cmd.timeNs) / 1e6);
     }
 
-    // (Water climbing logic removed)
-
-    // Priority: If Climbing (setVelocity is true), override everything immediately.
-    // This allows catching ledges mid-jump without delay.
-    if (playerSt.setVelocity) {
-        auto ourVelo = playerSt.velocity;
-        _SetVelocity(controller, ourVelo);
+    if (charController->flags.any(RE::CHARACTER_FLAGS::kJumping)) {
+        climbers.lastJumpFrame[slot] = iFrameCount;
+        _SetVelocity(controller, a_velocity);
         return;
     }
-
-    if (auto charController = playerSt.player->GetCharController(); charController) {
-        if (charController->flags.any(RE::CHARACTER_FLAGS::kJumping)) {
-            playerSt.lastJumpFrame = iFrameCount;
-            _SetVelocity(controller, a_velocity);
-            return;
-        }
-    }
     
     // Jump Grace Period (Only applies if NOT climbing)
     int64_t conf_jumpExpireDur = 60; 
-    if (iFrameCount - playerSt.lastJumpFrame < conf_jumpExpireDur && iFrameCount - playerSt.lastJumpFrame > 0) {
+    const int64_t sinceJump = iFrameCount - climbers.lastJumpFrame[slot];
+    if (sinceJump < conf_jumpExpireDur && sinceJump > 0) {
         _SetVelocity(controller, a_velocity);
         return;
     }
 
-    bool isInMidAir = playerSt.player->IsInMidair();
-    playerSt.isInMidAir = isInMidAir;
-    if (!isInMidAir) playerSt.lastOngroundFrame = iFrameCount;
-
-    // (Old location of setVelocity check was here, now moved up)
+    bool isInMidAir = climbers.actor[slot]->IsInMidair();
+    climbers.inMidAir[slot] = isInMidAir;
+    if (!isInMidAir) climbers.lastOngroundFrame[slot] = iFrameCount;
     
     _SetVelocity(controller, a_velocity);
 }
@@ -89,10 +77,36 @@ void ZacOnFrame::HookSetVelocity(RE::bhkCharProxyController* controller, const R
 bool isOurFnRunning = false;
 int64_t count_after_pause;
 
+// Frame trace recorder ([Debug] bRecordTrace)
+Climb::TraceWriter traceWriter;
+const char* tracePath = "Data/SKSE/Plugins/FreeClimbVR_Trace.bin";
+// Chrome trace-event JSON ([Debug] bTraceEvents, FREECLIMB_PROFILE builds)
+[[maybe_unused]] const char* eventTracePath = "Data/SKSE/Plugins/FreeClimbVR_Events.json";
+// Grip presses further back than this (s) anchor at the current hand pose
+constexpr double kMaxGripRewind = 0.1;
+
 
 
 void ZacOnFrame::OnFrameUpdate() {
-    if (Settings::GetSingleton()->activeSettings.bEnableWholeMod == false) {
+    CLIMB_TRACE_SPAN("OnFrameUpdate");
+    // Settings reloaded in the background take effect here, between frames
+    Settings::GetSingleton()->Update();
+
+#ifdef FREECLIMB_PROFILE
+    // [Debug] bTraceEvents starts/stops the Perfetto trace (the file is complete once it stops)
+    auto& tracer = Climb::EventTracer::Get();
+    if (Settings::GetSingleton()->Current().bTraceEvents != tracer.Enabled()) {
+        if (tracer.Enabled()) {
+            tracer.Stop();
+            log::info("Event trace closed: {} events, {} dropped", tracer.Written(), tracer.Dropped());
+        } else if (tracer.Start(eventTracePath)) {
+            log::info("Recording event trace to {}", eventTracePath);
+        }
+    }
+#endif
+
+    if (Settings::GetSingleton()->activeSettings->bEnableWholeMod == false) {
+        PlayerState::climbers.Bind(PlayerState::kSlot, 0); // Hand the player's controller back to the game
         ZacOnFrame::_OnFrame();  
         return;
     }
@@ -118,18 +132,6 @@ void ZacOnFrame::OnFrameUpdate() {
 
         if (!ui->GameIsPaused() && count_after_pause <= 0) {
             
-            // Race Detection / Settings Update (Every ~1 sec)
-            if (iFrameCount % 60 == 0) {
-                 if (auto player = RE::PlayerCharacter::GetSingleton()) {
-                     if (auto race = player->GetRace()) {
-                         const char* rid = race->GetFormEditorID();
-                         if (rid) {
-                             Settings::GetSingleton()->ApplyRace(rid);
-                         }
-                     }
-                 }
-            }
-
             // MAIN CLIMBING LOGIC
             // Calc dt in seconds
             float dt = (float)dur_last.count() / 1000000.0f;
@@ -138,6 +140,18 @@ void ZacOnFrame::OnFrameUpdate() {
             
         }
     }
+
+#ifdef FREECLIMB_PROFILE
+    // Periodic stage timing report; each one covers the frames since the last
+    if (const float interval = Settings::GetSingleton()->Current().fProfileInterval; interval > 0.0f) {
+        static auto lastReport = now;
+        if (now - lastReport >= std::chrono::duration<float>(interval)) {
+            lastReport = now;
+            LogStageTimings(false);
+            Climb::StageProfiler::Get().Reset();
+        }
+    }
+#endif
     
     // Important: Call original OnFrame
     ZacOnFrame::_OnFrame();
@@ -149,403 +163,261 @@ void ZacOnFrame::OnFrameUpdate() {
 void ZacOnFrame::ClimbMain(float dt) {
     auto& playerSt = PlayerState::GetSingleton();
     auto player = playerSt.player;
-    if (!player || !player->Is3DLoaded()) return;
+    if (!player || !player->Is3DLoaded()) {
+        playerSt.BindController(nullptr);
+        return;
+    }
+    CLIMB_PROFILE_STAGE(kClimbMain);
+    // The controller is recreated with the player's 3D; keep the hook's lookup on the live one
+    playerSt.BindController(player->GetCharController());
 
-    // Update basic states (Hand buffers for velocity calculation)
-    playerSt.UpdateSpeedBuf();
+    // Engine pointers: re-resolved only after a 3D reload or cell change
+    auto playerCh = RE::PlayerCharacter::GetSingleton();
+    auto& handles = playerSt.handles;
+    handles.Refresh(playerCh);
 
-    // Climbing Logic Variables
-    RE::NiPoint3 totalClimbVelo(0.0f, 0.0f, 0.0f);
-    bool isClimbing = false;
-    int handsActive = 0;
+    // Update basic states (Hand buffers for velocity calculation)
+    {
+        CLIMB_PROFILE_STAGE(kSpeedBuffer);
+        playerSt.UpdateSpeedBuf();
+    }
 
     // Settings from INI (Using Active Settings which includes Race Overrides)
-    auto& settings = Settings::GetSingleton()->activeSettings;
-    float forceMulti = settings.fForceMulti;
-    float rayDist = settings.fRayDist; 
-    
-    // Internal State
-    static bool isHoldingL = false;
-    static bool isHoldingR = false;
-    static RE::NiPoint3 grabPointL; // Captured grab position
-    static RE::NiPoint3 grabPointR; 
-    static RE::NiPoint3 wallNormalL; // Captured wall normal
-    static RE::NiPoint3 wallNormalR;
-
-    static bool mustReleaseL = false;
-    static bool mustReleaseR = false;
-    
-    // Smoothing State
-    static bool wasClimbing = false;
-    static float smoothingTimer = 0.0f;
-    static RE::NiPoint3 entryVelo;
-    static RE::NiPoint3 lastAppliedVelo; // To preserve momentum on release
-    static float postReleaseTimer = 0.0f;   // Timer for sustained push-off
-    static RE::NiPoint3 retainedWallNormal; // Wall normal at moment of release
-    
-    // Throw Window Tracker
-    static RE::NiPoint3 peakThrowVelo(0,0,0);
-    static float peakThrowTimer = 0.0f;
-    
-    // Haptic Cooldowns
-    static int hapticCoolL = 0;
-    static int hapticCoolR = 0;
-    if (hapticCoolL > 0) hapticCoolL--;
-    if (hapticCoolR > 0) hapticCoolR--;
-    
-    // Hover Haptic Skippers
-    static int hoverSkip[2] = {0, 0};
-    
-    // Helper to update retained normal
-    auto updateRetainedNormal = [&]() {
-        RE::NiPoint3 n(0,0,0);
-        int c = 0;
-        if (isHoldingL) { n += wallNormalL; c++; }
-        if (isHoldingR) { n += wallNormalR; c++; }
-        if (c > 0) {
-            n.x /= c; n.y /= c; n.z /= c;
-            // Normalize
-            float len = n.Length();
-            if (len > 0.001f) {
-                n.x /= len; n.y /= len; n.z /= len;
-                retainedWallNormal = n;
+    auto& settings = *Settings::GetSingleton()->activeSettings;
+    auto& solver = playerSt.solver;
+
+    // Surface memory is per cell: drop it when the player leaves the cell it was built in
+    std::size_t surfaceCap = std::bit_ceil(static_cast<std::size_t>(std::clamp(settings.iSurfaceCacheSize, 0, 65536)));
+    if (settings.iSurfaceCacheSize <= 0) surfaceCap = 0;
+    if (playerSt.surfaceHash.Capacity() != surfaceCap) playerSt.surfaceHash.Reset(surfaceCap);
+    if (handles.CellGeneration() != playerSt.surfaceCellGen) {
+        playerSt.surfaceHash.Clear();
+        playerSt.hoverCache.Invalidate(); // Cached hits point at references of the old cell
+        playerSt.surfaceCellGen = handles.CellGeneration();
+    }
+
+    auto inputMgr = InputManager::GetSingleton();
+
+    // 1. Gather per-hand inputs for the solver
+    Climb::FrameInput in;
+    in.dt = dt;
+    RE::TESObjectREFR* hitRefs[2] = {nullptr, nullptr}; // For grab sounds
+    bool anyGripping = false;
+
+    bool probe[2] = {false, false};
+    bool gripping[2] = {false, false};
+    for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+        bool isLeft = hand == Climb::kLeft;
+        auto& handIn = in.hands[hand];
+
+        if (inputMgr) {
+            handIn.gripping = isLeft ? inputMgr->IsLeftGripPressed() : inputMgr->IsRightGripPressed();
+        }
+        gripping[hand] = handIn.gripping;
+        anyGripping |= handIn.gripping;
+
+        auto handNode = handles.VRHand(hand);
+        if (!handNode) continue;
+        handIn.tracked = true;
+        handIn.position = ToVec3(handNode->world.translate);
+        handIn.velocity = playerSt.GetHandVelocity(hand, settings);
+
+        // First frame of a new grip press: grab (and cast) from where the hand was when the grip
+        // was squeezed, not where it got to by the frame that sees it
+        if (handIn.gripping) {
+            const auto pressedAt = inputMgr->GripPressedAt(isLeft);
+            if (pressedAt != playerSt.anchoredPress[hand]) {
+                playerSt.anchoredPress[hand] = pressedAt;
+                handIn.position = Climb::PositionAtTime(handIn.position, playerSt.handRing[hand], playerSt.bodyRing,
+                                                        pressedAt * 1e-9, kMaxGripRewind);
             }
         }
-    };
-
-    // Check Hands
-    auto checkHand = [&](bool isLeft) {
-        bool& isHolding = isLeft ? isHoldingL : isHoldingR;
-        RE::NiPoint3& grabPoint = isLeft ? grabPointL : grabPointR;
-        RE::NiPoint3& wallNormal = isLeft ? wallNormalL : wallNormalR;
-        bool& mustRelease = isLeft ? mustReleaseL : mustReleaseR;
-        int& hapticCool = isLeft ? hapticCoolL : hapticCoolR;
-        int hIdx = isLeft ? 0 : 1;
-
-        // 1. Check Grip Input
-        bool isGripping = false;
-        if (auto inputMgr = InputManager::GetSingleton()) {
-            isGripping = isLeft ? inputMgr->IsLeftGripPressed() : inputMgr->IsRightGripPressed();
+
+        // Every frame while not holding, to allow hover detection
+        probe[hand] = solver.WantsProbe(hand, handIn.gripping);
+    }
+
+    // RAYCAST CHECK (both hands in one batch)
+    // Hover-only queries are answered from the coherence cache while the hand is nearly still.
+    ClimbHitData hits[2];
+    bool cast[2] = {false, false};
+    Climb::Vec3 forward[2];
+    Climb::HitCacheParams cacheParams{settings.fHoverCacheMove,
+                                      std::cos(settings.fHoverCacheAngle * std::numbers::pi_v<float> / 180.0f),
+                                      settings.iHoverCacheFrames};
+    for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+        if (!probe[hand]) continue;
+        auto handNode = handles.VRHand(hand);
+        const auto& rot = handNode->world.rotate;
+        forward[hand] = {rot.entry[0][1], rot.entry[1][1], rot.entry[2][1]};
+        if (auto cached = playerSt.hoverCache.Lookup(hand, in.hands[hand].position, forward[hand], gripping[hand], cacheParams)) {
+            hits[hand] = *cached;
+            continue;
         }
-        
-        // Handle Release
-        if (!isGripping) {
-            isHolding = false;
-            mustRelease = false;
-             // DO NOT RETURN! We must check for Hover.
+        if (!gripping[hand]) {
+            // Hover only: a remembered climbable surface in reach is enough
+            auto start = in.hands[hand].position + forward[hand] * Climb::kRayStartOffset;
+            auto known = playerSt.surfaceHash.Query(start, forward[hand], settings.fRayDist, static_cast<std::uint32_t>(iFrameCount));
+            if (known.hit) {
+                auto& h = hits[hand];
+                h.hit = true;
+                h.normal = ToNiPoint3(known.sample.normal);
+                h.point = ToNiPoint3(known.sample.point);
+                h.layer = known.sample.layer;
+                h.formID = known.sample.refrFormID; // Never the reference: see Remembered
+                h.distance = known.distance;
+                playerSt.hoverCache.Store(hand, in.hands[hand].position, forward[hand], h);
+                continue;
+            }
         }
+        cast[hand] = true;
+    }
 
-        if (mustRelease) return; // Wait for release
-
-        // 2. Check Collision / Hold State
-        auto playerCh = RE::PlayerCharacter::GetSingleton();
-        if (!playerCh) return;
-        auto vrData = playerCh->GetVRNodeData();
-        auto handNode = isLeft ? vrData->NPCLHnd : vrData->NPCRHnd;
-        if (!handNode) return;
+    if (cast[Climb::kLeft] || cast[Climb::kRight]) {
+        ClimbHitData fresh[2];
+        CLIMB_PROFILE_STAGE(kCollision);
+        CheckClimbCollision(handles, cast, in.hands, settings.fRayDist, playerSt.rayPlanner, &playerSt.surfaceHash, fresh);
+        for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+            if (!cast[hand]) continue;
+            hits[hand] = fresh[hand];
+            if (!gripping[hand]) playerSt.hoverCache.Store(hand, in.hands[hand].position, forward[hand], Remembered(fresh[hand]));
+        }
+    }
 
-        bool collision = false;
-        
-        // RAYCAST CHECK
-        // We check every frame if not holding, to allow hover detection
-        if (!isHolding) {
-             auto hitData = CheckClimbCollision(player, isLeft, rayDist);
-             if (hitData.hit) {
-                 // --- HOVER LOGIC ---
-                 if (!isGripping && settings.bEnableHaptics) {
-                     // Subtle Pulse: Intensity 1 (Min), Duration 1ms, Interval 15 frames
-                     // This simulates "Weak" vibration on VRIK/Oculus
-                     if (hoverSkip[hIdx]++ > 15) {
-                         vibrateController(1, 1000, isLeft);
-                         hoverSkip[hIdx] = 0;
-                     }
-                 }
-                 
-                 // --- GRAB LOGIC ---
-                 if (isGripping) {
-                     // v1.3 Restoration: Safety & Ice Checks
-                     if (hitData.refr) {
-                         // 1. Self Grab Prevention
-                         if (hitData.refr->formID == 0x14) {
-                             // Do nothing, fail grab silently
-                         } 
-                         // 2. Ice Check
-                         else if (IsIce(hitData.refr) && !IsClimbingTool(player, isLeft)) {
-                             SKSE::log::info("Slipped on ICE! (Need Axe/Tools)");
-                             // Play slip sound?
-                             // Fail grab
-                         }
-                         else {
-                             // Success
-                             collision = true;
-                             isHolding = true;
-                             grabPoint = handNode->world.translate;
-                             wallNormal = hitData.normal;
-                             
-                             // Play Material Sound
-                             Sound::PlayClimbSound(hitData.refr, playerCh);
-                             
-                             const char* n = hitData.refr->GetName();
-                             // SKSE::log::info("Grab Success: {}", n ? n : "Obj"); // Debug removed for cleanup
-
-                             // Haptic Feedback (CLICK)
-                             if (hapticCool <= 0 && settings.bEnableHaptics) {
-                                 vibrateController(2, 40000, isLeft); // Impact click
-                                 hapticCool = 30; 
-                             }
-                         }
-                     } else {
-                         // Static World Geometry -> Always grabbable
-                         collision = true;
-                         isHolding = true;
-                         grabPoint = handNode->world.translate;
-                         wallNormal = hitData.normal;
-                         
-                         // Play Default Sound (Stone/Static)
-                         Sound::PlayClimbSound(nullptr, playerCh);
-                         
-                         if (hapticCool <= 0 && settings.bEnableHaptics) {
-                             vibrateController(2, 40000, isLeft); 
-                             hapticCool = 30; 
-                         }
-                     }
-                 }
-                 
-             } else {
-                 // No hit, reset hoverskip to avoid "stored" tick
-                 hoverSkip[hIdx] = 10;
-             }
-        } else {
-             // Already Holding - Sticky Logic
-             collision = true; 
-             
-             // Check Arm Stretch
-             RE::NiPoint3 currentHandPos = handNode->world.translate;
-             float dist = currentHandPos.GetDistance(grabPoint);
-             
-             if (dist > settings.fMaxArmLength) {
-                 isHolding = false;
-                 mustRelease = true;
-                 collision = false;
-             }
+    for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+        if (!probe[hand]) continue;
+        const auto& hitData = hits[hand];
+        auto& handIn = in.hands[hand];
+        handIn.hit.hit = hitData.hit;
+        handIn.hit.normal = ToVec3(hitData.normal);
+        if (hitData.hit) handIn.hit.refrFormID = hitData.formID;
+        // Only a fresh cast carries the reference (grabs always cast; cache and surface hash hits have none)
+        if (hitData.hit && hitData.refr) {
+            hitRefs[hand] = hitData.refr;
+            // v1.3 Restoration: Ice Checks (only matter for a grab attempt)
+            if (handIn.gripping && hitData.formID != Climb::kPlayerRefID) {
+                handIn.hit.isIce = IsIce(hitData.refr);
+                if (handIn.hit.isIce) handIn.hasClimbingTool = IsClimbingTool(player, hand == Climb::kLeft);
+            }
         }
+    }
 
-        // 3. Apply Climbing
-        if (collision) {
-             handsActive++;
-             RE::NiPoint3 handVelo = playerSt.speedBuf.GetVelocity(3, isLeft);
-             totalClimbVelo -= handVelo; 
-             isClimbing = true;
+    if (Settings::GetSingleton()->Current().bLogRayStats && iFrameCount % 900 == 0) {
+        const auto& rs = playerSt.rayPlanner.Stats();
+        const auto& cs = playerSt.hoverCache.Stats();
+        log::info("Climb rays: {:.2f} per probing frame over {} frames (fan casts {}, probe casts {}, sweep rays {})",
+                  rs.RaysPerFrame(), rs.frames, rs.fanCasts, rs.probeCasts, rs.sweepCasts);
+        log::info("Grab look-ahead: {} of {} grabs won by prediction", rs.predictedGrabs, rs.grabs);
+        const auto& ss = playerSt.surfaceHash.Stats();
+        log::info("Hover cache: {:.1f}% hits ({} hits / {} misses)", cs.HitRatio() * 100.0, cs.hits, cs.misses);
+        log::info("Surface hash: {}/{} queries answered, {} inserts, {} evictions, {} KB", ss.answered, ss.queries,
+                  ss.inserts, ss.evictions, playerSt.surfaceHash.MemoryBytes() / 1024);
+        playerSt.rayPlanner.ResetStats();
+        playerSt.hoverCache.ResetStats();
+        playerSt.surfaceHash.ResetStats();
+        const auto& hs = GetHapticStats();
+        if (hs.seconds > 0.0) {
+            log::info("Haptics: {} pulse requests -> {} VM dispatches ({} for both hands), {:.1f} dispatches/s removed",
+                      hs.requests, hs.dispatches, hs.shared,
+                      (static_cast<double>(hs.requests) - static_cast<double>(hs.dispatches)) / hs.seconds);
         }
-    };
-
-    checkHand(true); 
-    checkHand(false); 
-
-    if (isClimbing) {
-        updateRetainedNormal(); // Update normal continuously while holding
-        postReleaseTimer = 0.0f; // Reset timer
-
-        // Transition Check (Start of climb)
-        if (!wasClimbing) {
-             // Reset Peak Tracker
-             entryVelo = {0,0,0};
-             peakThrowVelo = {0,0,0};
-             
-             // Capture current failing velocity
-             if (auto charCont = player->GetCharController()) {
-                 RE::hkVector4 hkVelo;
-                 charCont->GetLinearVelocityImpl(hkVelo);
-                 entryVelo = Quad2Velo(hkVelo);
-                 
-                 // Smart Smoothing:
-                 // Only smooth if we already had significant momentum (flying/falling).
-                 // If we were stopped/grounded, DO NOT SMOOTH. Only immediate velocity can break ground friction.
-                 if (entryVelo.Length() < 50.0f) {
-                     smoothingTimer = 0.0f; // Instant grab from ground
-                 } else {
-                     smoothingTimer = settings.fGrabSmoothing;
-                 }
-             } else {
-                 entryVelo = {0,0,0};
-                 smoothingTimer = 0.0f;
-             }
-             
-             // FIX: Cancel Jump Animation (Global - Once per climb)
-             player->NotifyAnimationGraph("JumpLand");
-         }
-
-        // Stamina Logic
-        float currentStamina = -1.0f;
-        
-        // Ensure we can access actor value
+        ResetHapticStats();
+    }
+
+    auto charCont = player->GetCharController();
+    in.hasCharController = charCont != nullptr;
+    if (anyGripping) {
+        // Climbing needs a grip, so stamina and entry velocity are only read then
+        CLIMB_PROFILE_STAGE(kActorValues);
         if (auto avOwner = player->AsActorValueOwner()) {
-             currentStamina = avOwner->GetActorValue(RE::ActorValue::kStamina);
+            in.stamina = avOwner->GetActorValue(RE::ActorValue::kStamina);
         }
-        
-        if (settings.bEnableStamina && currentStamina >= 0.0f && currentStamina <= 1.0f) { // Consider < 1.0 as depleted to be safe
-             // Force Release
-             if (iFrameCount % 60 == 0) log::info("Stamina depleted! forcing release.");
-             isHoldingL = false; isHoldingR = false;
-             mustReleaseL = true; mustReleaseR = true;
-             
-        } else {
-            // Apply Velocity
-            totalClimbVelo = totalClimbVelo * forceMulti;
-            
-            /* REMOVED: Causing lateral drift (Pushing player sideways)
-            // Constant Wall Push-Off (Safety Cushion)
-            if (retainedWallNormal.Length() > 0.1f) {
-                totalClimbVelo += (retainedWallNormal * 2.0f);
-            }
-            */
-
-            // SMOOTHING BLEND
-            if (smoothingTimer > 0.0f && settings.fGrabSmoothing > 0.0f) {
-                float t = 1.0f - (smoothingTimer / settings.fGrabSmoothing); // 0.0 to 1.0
-                // Clamp t (just in case)
-                if (t < 0.0f) t = 0.0f; if (t > 1.0f) t = 1.0f;
-                
-                // Lerp: entryVelo -> totalClimbVelo
-                RE::NiPoint3 diff = totalClimbVelo - entryVelo;
-                totalClimbVelo = entryVelo + (diff * t);
-                
-                smoothingTimer -= dt;
-            }
+        if (charCont && !solver.IsClimbing()) {
+            RE::hkVector4 hkVelo;
+            charCont->GetLinearVelocityImpl(hkVelo);
+            in.charVelocity = ToVec4(hkVelo);
+        }
+    }
 
-            // --- V2.4 MOTION SMOOTHING (Fix Jitter/Disorientation) ---
-            // Filters out high-frequency noise from hand tracking and sudden spikes.
-            // Alpha 0.4 provides a good balance between responsiveness and stability.
-            // Static storage is simple for single-player.
-            static RE::NiPoint3 s_lastFrameVelo = {0.0f, 0.0f, 0.0f};
-            
-            // Reset history on new climb
-            if (!wasClimbing) {
-                s_lastFrameVelo = totalClimbVelo;
-            }
-            
-            float kAlpha = settings.fMotionSmoothing;
-            if (kAlpha < 0.01f) kAlpha = 0.01f; // Avoid complete freeze
-            if (kAlpha > 1.0f) kAlpha = 1.0f;
-             
-            totalClimbVelo = (totalClimbVelo * kAlpha) + (s_lastFrameVelo * (1.0f - kAlpha));
-            s_lastFrameVelo = totalClimbVelo;
-            // --------------------------------------------------------
-
-            // Stamina Drain
-            if (settings.bEnableStamina) {
-                if (auto avOwner = player->AsActorValueOwner()) {
-                    float velocityMagnitude = totalClimbVelo.Length();
-                    
-                    float costMove = settings.fStaminaCostMove;
-                    float costIdle = settings.fStaminaCostIdle;
-                    float moveThres = settings.fStaminaMovementThreshold;
-    
-                    float staminaCost = (velocityMagnitude > moveThres) ? costMove : costIdle;
-                    
-                    // One Hand Penalty
-                    if (handsActive == 1) {
-                        staminaCost *= settings.fStaminaOneHandCostMult;
-                    }
-
-                    avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kStamina, -staminaCost);
-                }
-            }
+    // 2. Solve
+    // A trace opens only between climbs, with the solver started over and a reset record in the
+    // file, so the replay's fresh solver sees exactly what this one does.
+    const bool recordTrace = Settings::GetSingleton()->Current().bRecordTrace;
+    if (recordTrace && !traceWriter.IsOpen() && solver.IsIdle()) {
+        solver.Reset();
+        if (traceWriter.Open(tracePath)) log::info("Recording frame trace to {}", tracePath);
+    } else if (!recordTrace && traceWriter.IsOpen()) {
+        traceWriter.Close();
+    }
+#ifdef FREECLIMB_PROFILE
+    const bool wasHolding[2] = {solver.IsHolding(Climb::kLeft), solver.IsHolding(Climb::kRight)};
+#endif
+    Climb::FrameCommand cmd;
+    {
+        CLIMB_PROFILE_STAGE(kSolve);
+        cmd = solver.Step(in, settings);
+    }
 
-            // Fling / Throw Mechanics
-            if (handsActive >= 2 && totalClimbVelo.z > 0.0f) {
-                 float throwMult = settings.fThrowMult;
-                 
-                 totalClimbVelo.z *= throwMult; // Climbing boost
-                 
-                 float releaseThres = settings.fThrowReleaseThreshold;
-                 if (totalClimbVelo.z > releaseThres) {
-                     // Strong fling detected
-                     isHoldingL = false; isHoldingR = false;
-                     mustReleaseL = true; mustReleaseR = true;
-                 }
-            }
+    if (traceWriter.IsOpen()) {
+        Climb::Vec3 relPos[2] = {playerSt.handRing[Climb::kLeft].Latest(), playerSt.handRing[Climb::kRight].Latest()};
+        traceWriter.Write(in, cmd, relPos, settings);
+    }
 
-            // SAFETY: Clamp Maximum Velocity (Anti-Space Launch)
-            float vLen = totalClimbVelo.Length();
-            if (vLen > settings.fMaxVelocity) {
-                totalClimbVelo = totalClimbVelo * (settings.fMaxVelocity / vLen);
-            }
-            
-            // Wall Push-Off Logic was removed here to prevent player drift.
-            
-            lastAppliedVelo = totalClimbVelo; // Store for release
+    // 3. Apply side effects
+    for (int hand = Climb::kLeft; hand <= Climb::kRight; hand++) {
+        bool isLeft = hand == Climb::kLeft;
+        const auto& ev = cmd.hands[hand];
+        if (ev.hoverPulse) vibrateController(1, 1000, isLeft); // "Weak" hover pulse on VRIK/Oculus
+        if (ev.iceSlip) CLIMB_LOG_EVERY(info, 2.0, "Slipped on ICE! (Need Axe/Tools)");
+#ifdef FREECLIMB_PROFILE
+        if (ev.grabbed) CLIMB_TRACE_INSTANT(hits[hand].predicted ? "PredictedGrab" : "Grab", hand);
+        if (wasHolding[hand] && !solver.IsHolding(hand)) CLIMB_TRACE_INSTANT("Release", hand);
+#endif
+        if (ev.grabbed) {
+            playerSt.rayPlanner.CountGrab(hits[hand].predicted);
+            // nullptr ref = Stone/Static
+            CLIMB_PROFILE_STAGE(kSound);
+            Sound::PlayClimbSound(hitRefs[hand], handles.VRHand(hand), isLeft);
+        }
+        if (ev.clickPulse) vibrateController(2, 40000, isLeft);           // Impact click
+    }
+    {
+        CLIMB_PROFILE_STAGE(kHaptics);
+        FlushHaptics(); // One VM dispatch per pulsing hand, or one for both on the Game backend
+    }
 
-            // TRACK PEAK VELOCITY (For generous throw window)
-            // If current upward velocity is higher than recorded peak, update it.
-            if (totalClimbVelo.z > peakThrowVelo.z) {
-                peakThrowVelo = totalClimbVelo;
-                peakThrowTimer = settings.fThrowTimeWindow; // Configurable window
-            }
-            peakThrowTimer -= dt;
-            if (peakThrowTimer <= 0.0f) {
-                peakThrowVelo = totalClimbVelo; // Reset to current if timed out
-            }
+    if (cmd.startedClimb) {
+        // FIX: Cancel Jump Animation (Global - Once per climb)
+        player->NotifyAnimationGraph("JumpLand");
+    }
 
-            playerSt.SetVelocity(totalClimbVelo.x, totalClimbVelo.y, totalClimbVelo.z);
-            
-            // Cancel Fall Damage & Animation logic (Only while actively holding)
-            // ALWAYS Reset Fall Logic while holding (Essential for correct "Normal" physics)
-            if (player->GetCharController()) {
-                 player->GetCharController()->fallStartHeight = 0.0f;
-                 player->GetCharController()->fallTime = 0.0f;
-            }
-            player->SetGraphVariableFloat("FallTime", 0.0f);
-            
-            playerSt.setVelocity = true;
-        }
-    } else {
-        playerSt.setVelocity = false;
-        
-        // SAFETY: Post-Climb Immunity (If Enabled)
-        if (postReleaseTimer > 0.0f && settings.bDisableFallDamage) {
-             if (player->GetCharController()) {
-                 player->GetCharController()->fallStartHeight = 0.0f;
-                 player->GetCharController()->fallTime = 0.0f;
-             }
-        }
-        
-        // MOMENTUM INJECTION (The Fling Fix)
-        if (wasClimbing) {
-            postReleaseTimer = 2.0f; // Start Push-Off Timer
-            
-            // We just released the wall. Transfer momentum to game physics.
-             if (auto charCont = player->GetCharController()) {
-                 
-                 // Which velocity to use? The instant one or the peak recent one?
-                 // Use Peak if it offers better upward momentum (Fling)
-                 RE::NiPoint3 launchVelo = lastAppliedVelo;
-                 if (peakThrowVelo.z > launchVelo.z) {
-                     launchVelo = peakThrowVelo;
-                 }
-
-                 // Clamp Vertical Fling
-                 float finalZ = launchVelo.z;
-                 if (finalZ > settings.fMaxFlingVelocity) finalZ = settings.fMaxFlingVelocity;
-                 
-                 RE::hkVector4 hkVelo;
-                 hkVelo.quad = _mm_set_ps(0.0f, finalZ, launchVelo.y, launchVelo.x);
-                 
-                 // Apply slightly boosted momentum to help overcome air friction immediately
-                 // Don't boost if it's just a gentle release. Threshold 200.0 is reasonable.
-                 if (launchVelo.Length() > 200.0f) {
-                      charCont->SetLinearVelocityImpl(hkVelo);
-                 }
-                 
-                 // Reset trackers
-                 peakThrowVelo = {0,0,0};
-             }
+    if (cmd.staminaDepleted) {
+        CLIMB_LOG_EVERY(info, 2.0, "Stamina depleted! forcing release.");
+    }
+
+    if (cmd.staminaCost != 0.0f) {
+        CLIMB_PROFILE_STAGE(kActorValues);
+        if (auto avOwner = player->AsActorValueOwner()) {
+            avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kStamina, -cmd.staminaCost);
         }
-        
-        // (Post-release push logic removed to prevent drift)
     }
-    
-    wasClimbing = isClimbing; // Update state for next frame
+
+    // Cancel Fall Damage (while holding, and after release if bDisableFallDamage)
+    if (cmd.resetFallState && charCont) {
+        charCont->fallStartHeight = 0.0f;
+        charCont->fallTime = 0.0f;
+    }
+    if (cmd.resetFallAnim) {
+        player->SetGraphVariableFloat("FallTime", 0.0f);
+    }
+
+    // MOMENTUM INJECTION (The Fling Fix)
+    if (cmd.launch && charCont) {
+        charCont->SetLinearVelocityImpl(ToHkVector4(cmd.launchVelocity));
+    }
+
+    // One consistent {velocity, active} for HookSetVelocity, whichever thread it runs on
+    playerSt.PublishVelocity(cmd.setVelocity, cmd.velocity, iFrameCount);
 }
 
 // Cleanup
@@ -553,6 +425,10 @@ void ZacOnFrame::CleanBeforeLoad() {
     iFrameCount = 0;
     iLastPressGrip = 0;
     PlayerState::GetSingleton().Clear();
+    InputManager::GetSingleton()->ResetGrips(); // Release events during the load are lost
+    ResetSurfaceClassCache(); // Dynamic (FF) forms are reused across loads
+    traceWriter.Reset(Climb::TraceResetReason::kLoad);  // The solver was just cleared with the player state
+    traceWriter.Flush();
 }
 
 // Empty Stubs for any potential legacy links (though headers are clean now)
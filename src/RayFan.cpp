@@ -0,0 +1,136 @@
+#include "RayFan.h"
+#include "ClimbVec4.h"  // FREECLIMB_SSE (off with FREECLIMB_NO_SIMD)
+
+using namespace Climb;
+
+namespace {
+    // Ray direction weights in the hand frame and length relative to fRayDist.
+    // Order is priority: the first acceptable hit wins, so the legacy pair stays first.
+    struct FanRay {
+        float f, r, u, len;
+    };
+    constexpr FanRay kFan[kMaxFanRays] = {
+        {1.0f, 0.0f, 0.0f, 1.0f},     // Forward
+        {1.0f, 0.0f, -1.0f, 0.8f},    // Forward-down
+        {1.0f, -0.5f, 0.0f, 0.9f},    // Left
+        {1.0f, 0.5f, 0.0f, 0.9f},     // Right
+        {0.5f, 0.0f, -1.0f, 0.7f},    // Steep down (ledge top under the palm)
+        {1.0f, 0.0f, 0.5f, 0.9f},     // Up
+        {1.0f, -0.5f, -0.5f, 0.85f},  // Down-left
+        {1.0f, 0.5f, -0.5f, 0.85f},   // Down-right
+        {1.0f, 0.0f, -0.25f, 1.0f},   // Slightly down, full reach
+    };
+
+    int RayCount(ProbeMode mode, int fanRays) {
+        switch (mode) {
+            case ProbeMode::kProbe:
+                return 1;
+            case ProbeMode::kNear:
+            case ProbeMode::kLegacy:
+                return 2;
+            case ProbeMode::kFan:
+                return fanRays;
+            default:
+                return 0;
+        }
+    }
+
+#ifdef FREECLIMB_SSE
+    inline __m128 Load3(const Vec3& v) { return _mm_set_ps(0.0f, v.z, v.y, v.x); }
+#endif
+}
+
+void Climb::BuildRayBatch(const HandRayPose poses[2], const ProbeMode modes[2], float rayDist, int fanRays,
+                          RayBatch& out) {
+    if (fanRays < kMinFanRays) fanRays = kMinFanRays;
+    if (fanRays > kMaxFanRays) fanRays = kMaxFanRays;
+
+    int n = 0;
+    for (int hand = 0; hand < 2; hand++) {
+        const int count = RayCount(modes[hand], fanRays);
+        out.first[hand] = n;
+        out.count[hand] = count;
+        if (count == 0) continue;
+
+        const auto& pose = poses[hand];
+        const bool probe = modes[hand] == ProbeMode::kProbe || modes[hand] == ProbeMode::kNear;
+
+#ifdef FREECLIMB_SSE
+        const __m128 scale = _mm_set1_ps(kHavokScale);
+        const __m128 fwd = Load3(pose.forward);
+        const __m128 right = Load3(pose.right);
+        const __m128 up = Load3(pose.up);
+        const __m128 start = _mm_mul_ps(_mm_add_ps(Load3(pose.translate), _mm_mul_ps(fwd, _mm_set1_ps(kRayStartOffset))), scale);
+
+        for (int i = 0; i < count; i++, n++) {
+            const auto& ray = kFan[i];
+            __m128 dir = _mm_add_ps(_mm_mul_ps(fwd, _mm_set1_ps(ray.f)),
+                                    _mm_add_ps(_mm_mul_ps(right, _mm_set1_ps(ray.r)), _mm_mul_ps(up, _mm_set1_ps(ray.u))));
+            // Normalize (w lane is zero, so the horizontal sum is the xyz dot product)
+            __m128 sq = _mm_mul_ps(dir, dir);
+            __m128 sum = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 1, 2, 3)));
+            dir = _mm_div_ps(dir, _mm_sqrt_ps(sum));
+
+            float grab = rayDist * ray.len;
+            float len = (probe && i == 0) ? rayDist * kProbeReach : grab;
+            _mm_store_ps(out.from[n], start);
+            _mm_store_ps(out.to[n], _mm_add_ps(start, _mm_mul_ps(dir, _mm_set1_ps(len * kHavokScale))));
+            out.length[n] = len;
+            out.grabDist[n] = grab;
+            out.predicted[n] = false;
+        }
+#else
+        const Vec3 start = (pose.translate + pose.forward * kRayStartOffset) * kHavokScale;
+        for (int i = 0; i < count; i++, n++) {
+            const auto& ray = kFan[i];
+            Vec3 dir = pose.forward * ray.f + pose.right * ray.r + pose.up * ray.u;
+            dir = dir / dir.Length();
+
+            float grab = rayDist * ray.len;
+            float len = (probe && i == 0) ? rayDist * kProbeReach : grab;
+            Vec3 end = start + dir * (len * kHavokScale);
+            out.from[n][0] = start.x; out.from[n][1] = start.y; out.from[n][2] = start.z; out.from[n][3] = 0.0f;
+            out.to[n][0] = end.x; out.to[n][1] = end.y; out.to[n][2] = end.z; out.to[n][3] = 0.0f;
+            out.length[n] = len;
+            out.grabDist[n] = grab;
+            out.predicted[n] = false;
+        }
+#endif
+
+        // Sweep: from the palm along the predicted travel, then fRayDist further the same way
+        const float travel = pose.sweep.Length();
+        if (travel >= kMinSweep) {
+            const Vec3 start = pose.translate + pose.forward * kRayStartOffset;
+            const float len = travel + rayDist;
+            const Vec3 end = start + pose.sweep * (len / travel);
+            out.from[n][0] = start.x * kHavokScale; out.from[n][1] = start.y * kHavokScale; out.from[n][2] = start.z * kHavokScale; out.from[n][3] = 0.0f;
+            out.to[n][0] = end.x * kHavokScale; out.to[n][1] = end.y * kHavokScale; out.to[n][2] = end.z * kHavokScale; out.to[n][3] = 0.0f;
+            out.length[n] = len;
+            out.grabDist[n] = len;
+            out.predicted[n] = true;
+            out.count[hand]++;
+            n++;
+        }
+    }
+}
+
+ProbeMode RayFanPlanner::Plan(int hand, bool gripping, bool adaptive) const {
+    if (!adaptive) return ProbeMode::kLegacy;
+    if (gripping) return ProbeMode::kFan;  // Grab imminent
+    return nearSurface[hand] ? ProbeMode::kNear : ProbeMode::kProbe;
+}
+
+void RayFanPlanner::Report(int hand, float nearestDist, float rayDist) {
+    nearSurface[hand] = nearestDist >= 0.0f && nearestDist <= rayDist * kProbeReach;
+}
+
+void RayFanPlanner::CountFrame(const ProbeMode modes[2], int raysCast, int sweepsCast) {
+    stats.frames++;
+    stats.rays += raysCast;
+    stats.sweepCasts += sweepsCast;
+    for (int hand = 0; hand < 2; hand++) {
+        if (modes[hand] == ProbeMode::kFan) stats.fanCasts++;
+        if (modes[hand] == ProbeMode::kProbe) stats.probeCasts++;
+    }
+}
@@ -1,37 +1,32 @@
 #include "settings.h"
-#include <fstream>
+#include "Utils.h"
+#include "SettingsSchema.h"
 #include <string> // For std::string
-#include <map>    // For std::map
 
 // Global State Definitions
 int64_t iFrameCount = 0;
 int64_t iLastPressGrip = 0;
 std::chrono::steady_clock::time_point last_time;
 
-// Helper function to load a section into ClimbingSettings, using existing values as defaults
+// Helper function to load a section into ClimbingSettings, using existing values as defaults.
+// Out-of-range values are clamped (and logged) and the derived block is recomputed.
 void LoadSection(CSimpleIniA& a_ini, const char* section, Settings::ClimbingSettings& out) {
-    out.fStaminaCostMove = (float)a_ini.GetDoubleValue(section, "fStaminaCostMove", out.fStaminaCostMove);
-    out.fStaminaCostIdle = (float)a_ini.GetDoubleValue(section, "fStaminaCostIdle", out.fStaminaCostIdle);
-    out.fStaminaOneHandCostMult = (float)a_ini.GetDoubleValue(section, "fStaminaOneHandCostMult", out.fStaminaOneHandCostMult);
-    out.fStaminaMovementThreshold = (float)a_ini.GetDoubleValue(section, "fStaminaMovementThreshold", out.fStaminaMovementThreshold);
-
-    out.fForceMulti = (float)a_ini.GetDoubleValue(section, "fForceMulti", out.fForceMulti);
-    out.fRayDist = (float)a_ini.GetDoubleValue(section, "fRayDist", out.fRayDist);
-    out.fMaxArmLength = (float)a_ini.GetDoubleValue(section, "fMaxArmLength", out.fMaxArmLength);
-    out.fGrabSmoothing = (float)a_ini.GetDoubleValue(section, "fGrabSmoothing", out.fGrabSmoothing);
-
-    out.fThrowMult = (float)a_ini.GetDoubleValue(section, "fThrowMult", out.fThrowMult);
-    out.fThrowReleaseThreshold = (float)a_ini.GetDoubleValue(section, "fThrowReleaseThreshold", out.fThrowReleaseThreshold);
-    out.fThrowTimeWindow = (float)a_ini.GetDoubleValue(section, "fThrowTimeWindow", out.fThrowTimeWindow);
-    out.fMaxFlingVelocity = (float)a_ini.GetDoubleValue(section, "fMaxFlingVelocity", out.fMaxFlingVelocity);
-    
-    out.fMaxVelocity = (float)a_ini.GetDoubleValue(section, "fMaxVelocity", out.fMaxVelocity);
-    out.fMotionSmoothing = (float)a_ini.GetDoubleValue(section, "fMotionSmoothing", out.fMotionSmoothing);
-
-    out.bEnableHaptics = a_ini.GetBoolValue(section, "bEnableHaptics", out.bEnableHaptics);
-    out.bEnableStamina = a_ini.GetBoolValue(section, "bEnableStamina", out.bEnableStamina);
-    out.bDisableFallDamage = a_ini.GetBoolValue(section, "bDisableFallDamage", out.bDisableFallDamage);
-    out.bEnableWholeMod = a_ini.GetBoolValue(section, "bEnableWholeMod", out.bEnableWholeMod);
+    Climb::LoadFields(
+        out, [&](const char* key) { return a_ini.GetValue(section, key, nullptr); },
+        [&](const Climb::SettingField& field, Climb::FieldIssue issue, const char* text) {
+            if (issue == Climb::FieldIssue::kInvalid) {
+                log::warn("[{}] {} = '{}' is not a valid value, keeping {}", section, field.name, text, field.Get(out));
+            } else {
+                log::warn("[{}] {} = {} is outside [{}, {}], using {}", section, field.name, text, field.min, field.max, field.Get(out));
+            }
+        });
+
+    // Catch typos: a misspelled key would otherwise be ignored silently
+    CSimpleIniA::TNamesDepend keys;
+    a_ini.GetAllKeys(section, keys);
+    for (const auto& key : keys) {
+        if (!Climb::FindSetting(key.pItem)) log::warn("[{}] Unknown key {}", section, key.pItem);
+    }
 }
 
 Settings* Settings::GetSingleton() {
@@ -39,91 +34,239 @@ Settings* Settings::GetSingleton() {
     return &singleton;
 }
 
-void Settings::Load() {
+namespace {
+    const char* kSettingsPath = "Data/SKSE/Plugins/FreeClimbVR_Settings.ini";
+
+    // Built-in defaults, used for keys missing from the INI (and before the first load)
+    Settings::ClimbingSettings BuiltinDefaults() {
+        Settings::ClimbingSettings d;
+        for (const auto& field : Climb::kClimbingFields) field.Set(d, field.defaultValue);
+        Climb::UpdateDerived(d);
+        return d;
+    }
+}
+
+Settings::Settings() {
+    auto snap = std::make_shared<Snapshot>();
+    snap->defaultSettings = BuiltinDefaults();
+    snap->materials = Climb::MaterialMatcher::Defaults();
+    current = std::move(snap);
+    activeSettings = &current->defaultSettings;
+}
+
+namespace {
+    std::string ToLower(std::string_view text) {
+        std::string out(text);
+        std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return out;
+    }
+}
+
+// Reads game forms, so game thread only. The race arrays are fixed after data load, so the
+// watcher thread can keep matching profiles against this table on every reload.
+std::shared_ptr<const Settings::RaceIndex> Settings::IndexRaces() {
+    auto index = std::make_shared<RaceIndex>();
+    if (auto dataHandler = RE::TESDataHandler::GetSingleton()) {
+        for (auto race : dataHandler->GetFormArray<RE::TESRace>()) {
+            const char* id = race ? race->GetFormEditorID() : nullptr;
+            if (!id || !*id) continue;
+            index->try_emplace(ToLower(id), race->GetFormID());
+        }
+    }
+    return index;
+}
+
+std::shared_ptr<Settings::Snapshot> Settings::Load(const char* path, const RaceIndex* races) {
     CSimpleIniA ini;
     ini.SetUnicode();
-    
-    const char* path = "Data/SKSE/Plugins/FreeClimbVR_Settings.ini";
+
+    auto snap = std::make_shared<Snapshot>();
+    auto& d = snap->defaultSettings;
 
     // Initialize default settings with hardcoded values first
     // These will be used if the INI file or specific keys are missing
-    defaultSettings.fStaminaCostMove = 0.30f;
-    defaultSettings.fStaminaCostIdle = 0.02f;
-    defaultSettings.fStaminaOneHandCostMult = 2.0f;
-    defaultSettings.fMaxArmLength = 120.0f;
-    defaultSettings.fMaxVelocity = 1500.0f;
-    defaultSettings.fMaxFlingVelocity = 800.0f;
-    defaultSettings.fGrabSmoothing = 0.2f;
-    defaultSettings.fThrowMult = 1.5f;
-    defaultSettings.fForceMulti = 1.1f;
-    defaultSettings.fRayDist = 65.0f;
-    defaultSettings.fThrowReleaseThreshold = 180.0f;
-    defaultSettings.fThrowTimeWindow = 0.6f;
-    defaultSettings.fStaminaMovementThreshold = 10.0f;
-    defaultSettings.bEnableHaptics = true;
-    defaultSettings.bEnableStamina = true;
-    defaultSettings.bDisableFallDamage = true;
-    defaultSettings.bEnableWholeMod = true;
+    d = BuiltinDefaults();
 
     // Load the INI file
     SI_Error status = ini.LoadFile(path);
+    if (status < 0) log::info("{} not found, writing defaults", path);
 
     // Load Base "Climbing" section into defaultSettings
-    LoadSection(ini, "Climbing", defaultSettings);
-    activeSettings = defaultSettings; // Start with base settings
-
-    // Save back to ensure defaults are written if missing or file was new
-    // This also writes comments for new entries
-    ini.SetDoubleValue("Climbing", "fStaminaCostMove", defaultSettings.fStaminaCostMove, "# Stamina cost per frame while moving/climbing");
-    ini.SetDoubleValue("Climbing", "fStaminaCostIdle", defaultSettings.fStaminaCostIdle, "# Stamina cost per frame while just hanging");
-    ini.SetDoubleValue("Climbing", "fStaminaOneHandCostMult", defaultSettings.fStaminaOneHandCostMult, "# Stamina multiplier when using only 1 hand");
-    ini.SetDoubleValue("Climbing", "fMaxArmLength", defaultSettings.fMaxArmLength, "# Maximum distance between hand and grab point before auto-release");
-    ini.SetDoubleValue("Climbing", "fMaxVelocity", defaultSettings.fMaxVelocity, "# Safety limit for velocity to avoid physics explosions");
-    ini.SetDoubleValue("Climbing", "fMaxFlingVelocity", defaultSettings.fMaxFlingVelocity, "# Max vertical velocity for flung jumps");
-    ini.SetDoubleValue("Climbing", "fGrabSmoothing", defaultSettings.fGrabSmoothing, "# Time in seconds to smooth/dampen the grab impact");
-    ini.SetDoubleValue("Climbing", "fThrowMult", defaultSettings.fThrowMult, "# Multiplier for vertical velocity when throwing/flinging");
-    ini.SetDoubleValue("Climbing", "fForceMulti", defaultSettings.fForceMulti, "# General climbing speed multiplier");
-    ini.SetDoubleValue("Climbing", "fRayDist", defaultSettings.fRayDist, "# Max distance from hand to surface to grab");
-    ini.SetDoubleValue("Climbing", "fThrowReleaseThreshold", defaultSettings.fThrowReleaseThreshold, "# Vertical velocity threshold to auto-release hands");
-    ini.SetDoubleValue("Climbing", "fThrowTimeWindow", defaultSettings.fThrowTimeWindow, "# Time window (seconds) to remember peak velocity for fling");
-    ini.SetDoubleValue("Climbing", "fStaminaMovementThreshold", defaultSettings.fStaminaMovementThreshold, "# Velocity threshold to consider 'Moving' vs 'Idle'");
-    ini.SetBoolValue("Climbing", "bEnableHaptics", defaultSettings.bEnableHaptics, "# Enable controller vibration on grab");
-    ini.SetBoolValue("Climbing", "bEnableStamina", defaultSettings.bEnableStamina, "# Enable stamina drain system");
-    ini.SetBoolValue("Climbing", "bEnableWholeMod", defaultSettings.bEnableWholeMod, "# Master switch for the mod");
-
-    // Load Race Overrides
-    // Standard Skyrim Races
-    const char* races[] = {"NordRace", "KhajiitRace", "ArgonianRace", "OrcRace", "WoodElfRace", "HighElfRace", "DarkElfRace", "BretonRace", "RedguardRace", "ImperialRace"};
-    
-    for (const char* r : races) {
-        std::string sec = "Race_" + std::string(r);
-        if (ini.GetSection(sec.c_str())) {
-            // Found override section
-            ClimbingSettings raceSet = defaultSettings; // inherit base settings
-            LoadSection(ini, sec.c_str(), raceSet);     // apply overrides from INI
-            raceOverrides[r] = raceSet;                 // store
-            log::info("Loaded Race Override: {}", r);
+    LoadSection(ini, "Climbing", d);
+
+    // Developer options (not written back, opt-in only)
+    snap->bRecordTrace = ini.GetBoolValue("Debug", "bRecordTrace", false);
+    snap->bLogRayStats = ini.GetBoolValue("Debug", "bLogRayStats", false);
+    snap->fProfileInterval = (float)ini.GetDoubleValue("Debug", "fProfileInterval", 0.0);
+    snap->bTraceEvents = ini.GetBoolValue("Debug", "bTraceEvents", false);
+    std::string logLevel = ToLower(ini.GetValue("Debug", "sLogLevel", "info"));
+    snap->logLevel = spdlog::level::from_str(logLevel);
+    if (snap->logLevel == spdlog::level::off && logLevel != "off") {
+        log::warn("Unknown sLogLevel '{}', using info", logLevel);
+        snap->logLevel = spdlog::level::info;
+    }
+
+    // Keys missing from the file get their default written back with a comment.
+    // Keys already present are left alone, and the file is only saved if something was added.
+    bool missing = false;
+    auto absent = [&](const char* section, const char* key) {
+        if (ini.GetValue(section, key, nullptr)) return false;
+        missing = true;
+        return true;
+    };
+    auto EnsureDouble = [&](const char* section, const char* key, double value, const char* comment) {
+        if (absent(section, key)) ini.SetDoubleValue(section, key, value, comment);
+    };
+    auto EnsureLong = [&](const char* section, const char* key, long value, const char* comment) {
+        if (absent(section, key)) ini.SetLongValue(section, key, value, comment);
+    };
+    auto EnsureBool = [&](const char* section, const char* key, bool value, const char* comment) {
+        if (absent(section, key)) ini.SetBoolValue(section, key, value, comment);
+    };
+    for (const auto& field : Climb::kClimbingFields) {
+        switch (field.type) {
+        case Climb::SettingType::kFloat: EnsureDouble("Climbing", field.name, field.Get(d), field.comment); break;
+        case Climb::SettingType::kInt: EnsureLong("Climbing", field.name, (long)field.Get(d), field.comment); break;
+        case Climb::SettingType::kBool: EnsureBool("Climbing", field.name, field.Get(d) != 0.0, field.comment); break;
         }
     }
 
-    // Save the INI file back to disk, ensuring any new defaults or comments are written
-    ini.SaveFile(path);
+    // Material patterns (comma separated, case-sensitive). Keys missing from the INI get the built-in lists.
+    auto& materials = snap->materials;
+    for (auto mat : {Climb::Material::kWood, Climb::Material::kSnow, Climb::Material::kMetal, Climb::Material::kDirt, Climb::Material::kStone}) {
+        const char* key = Climb::MaterialMatcher::MaterialName(mat);
+        const char* list = ini.GetValue("Materials", key, nullptr);
+        if (!list) {
+            list = Climb::MaterialMatcher::DefaultPatterns(mat);
+            ini.SetValue("Materials", key, list, mat == Climb::Material::kWood ? "# Name/keyword patterns per climb sound material. First listed material wins: Wood, Snow, Metal, Dirt, Stone" : nullptr);
+            missing = true;
+        }
+        materials.AddPatternList(list, mat);
+    }
+    materials.Build();
+
+    // Grip decode table. Runtimes disagree on which device is which hand, hence the lists.
+    if (absent("Input", "sLeftDevices")) {
+        ini.SetValue("Input", "sLeftDevices", "1, 6", "# Input device numbers of the left controller (some VR setups report 6 instead of 1)");
+    }
+    if (absent("Input", "sRightDevices")) {
+        ini.SetValue("Input", "sRightDevices", "2, 5", "# Input device numbers of the right controller (some VR setups report 5 instead of 2)");
+    }
+    EnsureLong("Input", "iGripButton", 2, "# Button ID of the grip");
+    auto& gripDecoder = snap->gripDecoder;
+    gripDecoder.ClearDevices();
+    if (!gripDecoder.SetDeviceList(ini.GetValue("Input", "sLeftDevices", "1, 6"), 0)) log::warn("Ignoring invalid entries in sLeftDevices");
+    if (!gripDecoder.SetDeviceList(ini.GetValue("Input", "sRightDevices", "2, 5"), 1)) log::warn("Ignoring invalid entries in sRightDevices");
+    gripDecoder.SetGripButton((std::uint32_t)ini.GetLongValue("Input", "iGripButton", 2));
+
+    // Load Race Overrides: every [Race_<EditorID>] section, vanilla or not
+    auto& raceProfiles = snap->raceProfiles;
+    CSimpleIniA::TNamesDepend sections;
+    ini.GetAllSections(sections);
+    sections.sort(CSimpleIniA::Entry::LoadOrder());
+    for (const auto& section : sections) {
+        std::string_view name = section.pItem;
+        if (!name.starts_with("Race_") || name.size() <= 5) continue;
+        RaceProfile profile;
+        profile.editorID = name.substr(5);
+        profile.settings = d;                               // inherit base settings
+        LoadSection(ini, section.pItem, profile.settings);  // apply overrides from INI
+        raceProfiles.push_back(std::move(profile));
+        log::info("Loaded Race Override: {}", raceProfiles.back().editorID);
+    }
+
+    // Match the profiles to race forms (through the index, no form access from this thread)
+    if (races) {
+        for (auto& profile : raceProfiles) {
+            if (auto it = races->find(ToLower(profile.editorID)); it != races->end()) profile.raceID = it->second;
+            if (!profile.raceID) log::warn("Race override [Race_{}]: no race with that editor ID is loaded", profile.editorID);
+        }
+    }
+
+    // Only touch the user's file when a key was missing (new options, or no file at all)
+    if (missing) ini.SaveFile(path);
+    return snap;
+}
+
+void Settings::StartWatcher() {
+    if (watcher.joinable()) return;
+    watcher = std::jthread([this](std::stop_token stop) { WatchLoop(stop); });
 }
 
-void Settings::ApplyRace(const std::string& raceName) {
-    static std::string lastApplied = "";
-    if (lastApplied == raceName) return; // Prevent spam
+void Settings::OnDataLoaded() {
+    raceIndex.store(IndexRaces());
+    dataLoaded = true;
+    reloadRequested = true;
+}
 
-    if (raceOverrides.count(raceName)) {
-        activeSettings = raceOverrides[raceName];
-        log::info("Applied settings for race: {}", raceName);
-        RE::DebugNotification(("VRClimbing Profile: " + raceName).c_str());
-        lastApplied = raceName;
-    } else {
-        if (lastApplied != "Default") {
-             activeSettings = defaultSettings;
-             // log::info("Applied default settings (Race not found: {})", raceName);
-             lastApplied = "Default";
+void Settings::WatchLoop(std::stop_token stop) {
+    std::error_code ec;
+    std::filesystem::file_time_type lastWrite{};
+    bool loaded = false;
+    while (!stop.stop_requested()) {
+        auto writeTime = std::filesystem::last_write_time(kSettingsPath, ec);
+        if (ec) writeTime = {};
+        // Always consume the request, so a reload that also changed the file is not done twice
+        const bool requested = reloadRequested.exchange(false);
+        if (!loaded || writeTime != lastWrite || requested) {
+            try {
+                const auto races = raceIndex.load();
+                auto snap = Load(kSettingsPath, races.get());
+                pending.store(std::move(snap));
+                if (loaded) log::info("Settings file changed, reloaded");
+            } catch (...) {
+                log::error("Failed to load settings. Keeping the previous ones.");
+            }
+            loaded = true;
+            // Pick up our own write-back (if any) as the current version
+            lastWrite = std::filesystem::last_write_time(kSettingsPath, ec);
+            if (ec) lastWrite = {};
+        }
+        for (int i = 0; i < 10 && !stop.stop_requested() && !reloadRequested; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+}
+
+void Settings::Update() {
+    auto next = pending.exchange(nullptr);
+    if (!next) return;
+
+    previous = std::move(current);
+    current = std::move(next);
+    activeSettings = &current->defaultSettings;
+    spdlog::default_logger()->set_level(current->logLevel);
+    ResetSurfaceClassCache(); // Cached materials were computed from the old patterns
+
+    // Same race, new profile table
+    for (const auto& profile : current->raceProfiles) {
+        if (currentRace && profile.raceID == currentRace) {
+            activeSettings = &profile.settings;
+            break;
+        }
+    }
+    if (dataLoaded) ResolveHapticBackend(); // bUseVRIKHaptics may have changed
+}
+
+void Settings::ApplyRace(RE::TESRace* race) {
+    const RE::FormID raceID = race ? race->GetFormID() : 0;
+    currentRace = raceID;
+    const ClimbingSettings* next = &current->defaultSettings;
+    const RaceProfile* matched = nullptr;
+    for (const auto& profile : current->raceProfiles) {
+        if (raceID && profile.raceID == raceID) {
+            next = &profile.settings;
+            matched = &profile;
+            break;
         }
     }
-}
\ No newline at end of file
+    if (next == activeSettings) return; // Prevent spam
+
+    activeSettings = next;
+    if (matched) {
+        log::info("Applied settings for race: {}", matched->editorID);
+        RE::DebugNotification(("VRClimbing Profile: " + matched->editorID).c_str());
+    } else {
+        log::info("Applied default settings");
+    }
+}
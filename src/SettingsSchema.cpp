@@ -0,0 +1,33 @@
+#include "SettingsSchema.h"
+#include <cerrno>
+#include <cstdlib>
+
+using namespace Climb;
+
+bool Climb::ParseSettingValue(const SettingField& field, const char* text, double& out) {
+    if (!text || !*text) return false;
+    char* end = nullptr;
+    switch (field.type) {
+    case SettingType::kFloat:
+        out = std::strtod(text, &end);
+        return *end == '\0';
+    case SettingType::kInt: {
+        const bool hex = text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+        errno = 0;
+        const long value = std::strtol(text, &end, hex ? 16 : 10);
+        out = static_cast<double>(value);
+        return *end == '\0' && errno == 0;
+    }
+    case SettingType::kBool:
+        switch (text[0]) {
+        case 't': case 'T': case 'y': case 'Y': case '1': out = 1.0; return true;
+        case 'f': case 'F': case 'n': case 'N': case '0': out = 0.0; return true;
+        case 'o': case 'O':
+            if (text[1] == 'n' || text[1] == 'N') { out = 1.0; return true; }
+            if (text[1] == 'f' || text[1] == 'F') { out = 0.0; return true; }
+            return false;
+        default: return false;
+        }
+    }
+    return false;
+}
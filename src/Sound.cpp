@@ -1,5 +1,8 @@
 #include "Sound.h"
+#include "Utils.h"
+#include <chrono>
 #include <string>
+#include "VoicePool.h"
 
 namespace Sound {
 
@@ -10,62 +13,94 @@ namespace Sound {
         return nullptr;
     }
 
-    // Determine material type from reference
-    // This is a heuristic approach since direct physics material query is complex via SKSE
-    std::string PredictMaterial(RE::TESObjectREFR* ref) {
-        if (!ref) return "Stone"; // Default to Stone (Terrain/Walls)
+    // Determine material type from a base object
+    // Patterns come from the [Materials] INI section and are matched in a single pass
+    // (see MaterialMatcher.h). Results are cached per base form by GetSurfaceClass (Utils.h).
+    Climb::Material PredictMaterial(RE::TESBoundObject* base) {
+        using Climb::Material;
+        if (!base) return Material::kStone; // Default to Stone (Terrain/Walls)
 
-        auto base = ref->GetBaseObject();
-        if (!base) return "Stone";
+        const auto& matcher = Settings::GetSingleton()->Current().materials;
+        Material mat;
 
-        // 1. Check Keywords
-        // (Implementation omitted for brevity, requiring iteration over Keyword FormList)
-        
-        // 2. Check Name (Naive but effective for many objects)
-        const char* nameC = base->GetName();
-        if (nameC) {
-            std::string name = nameC;
-            // Lowercase for comparison could be better, but simple find works
-            if (name.find("Wood") != std::string::npos || name.find("Tree") != std::string::npos || name.find("Log") != std::string::npos || name.find("Plank") != std::string::npos) return "Wood";
-            if (name.find("Ice") != std::string::npos || name.find("Snow") != std::string::npos || name.find("Frozen") != std::string::npos) return "Snow";
-            if (name.find("Metal") != std::string::npos || name.find("Iron") != std::string::npos || name.find("Steel") != std::string::npos || name.find("Dwarven") != std::string::npos) return "Metal";
-            if (name.find("Dirt") != std::string::npos || name.find("Soil") != std::string::npos || name.find("Grass") != std::string::npos) return "Dirt";
-        }
+        // 1. Check Keywords (editor IDs survive at runtime for keywords), 2. Check Name
+        auto keywordForm = base->As<RE::BGSKeywordForm>();
+        auto keywordID = [&](std::uint32_t i) -> const char* {
+            auto keyword = keywordForm->keywords[i];
+            return keyword ? keyword->GetFormEditorID() : nullptr;
+        };
+        if (matcher.MatchSurface(keywordForm ? keywordForm->numKeywords : 0, keywordID, base->GetName(), mat)) return mat;
 
         // 3. Check Form Type
         auto type = base->GetFormType();
-        if (type == RE::FormType::Tree) return "Wood";
-        if (type == RE::FormType::Flora) return "Dirt";
+        if (type == RE::FormType::Tree) return Material::kWood;
+        if (type == RE::FormType::Flora) return Material::kDirt;
 
-        return "Stone";
+        return Material::kStone;
     }
 
-    void PlayClimbSound(RE::TESObjectREFR* surfaceRef, RE::Actor* player) {
-        if (!player) return;
+    namespace {
+        // Sound descriptor per material, resolved once at kDataLoaded
+        // (Standard Footsteps as placeholders; guaranteed to exist in Skyrim.esm)
+        constexpr const char* kMaterialSoundIDs[] = {
+            "FSTRunStone",  // kStone
+            "FSTRunWood",   // kWood
+            "FSTRunSnow",   // kSnow
+            "FSTRunMetal",  // kMetal (Or FSTArmorHeavyRun)
+            "FSTRunDirt",   // kDirt
+        };
+        static_assert(std::size(kMaterialSoundIDs) == static_cast<std::size_t>(Climb::Material::kCount));
+
+        RE::BGSSoundDescriptorForm* descriptors[std::size(kMaterialSoundIDs)]{};
+        RE::BSSoundHandle handles[Climb::VoicePool::kMaxVoices];
+        Climb::VoicePool voicePool;
+
+        float NowSeconds() {
+            static const auto start = std::chrono::steady_clock::now();
+            return std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
 
-        // 1. Identify Material
-        std::string mat = PredictMaterial(surfaceRef);
+    void ResolveSounds() {
+        for (std::size_t i = 0; i < std::size(kMaterialSoundIDs); i++) {
+            descriptors[i] = GetLegacySound(kMaterialSoundIDs[i]);
+            if (!descriptors[i]) SKSE::log::warn("Climb sound {} not found", kMaterialSoundIDs[i]);
+        }
+        voicePool.Reset();
+    }
 
-        // 2. Map to Sound Descriptor (Using Standard Footsteps as placeholders)
-        // These are guaranteed to exist in Skyrim.esm
-        const char* soundID = "FSTRunStone"; 
-        
-        if (mat == "Wood") soundID = "FSTRunWood";
-        else if (mat == "Snow") soundID = "FSTRunSnow";
-        else if (mat == "Metal") soundID = "FSTRunMetal"; // Or FSTArmorHeavyRun
-        else if (mat == "Dirt") soundID = "FSTRunDirt";
+    void PlayClimbSound(RE::TESObjectREFR* surfaceRef, RE::NiAVObject* handNode, bool isLeft) {
+        if (!handNode) return;
 
-        // 3. Play Sound
-        auto soundDesc = GetLegacySound(soundID);
-        if (soundDesc) {
-            RE::BSSoundHandle handle;
-            auto audioMgr = RE::BSAudioManager::GetSingleton();
-            if (audioMgr && audioMgr->BuildSoundDataFromDescriptor(handle, soundDesc)) {
-                // Set volume slightly lower for hands compared to feet
-                handle.SetVolume(0.6f); 
-                handle.SetPosition(player->GetPosition());
-                handle.Play();
+        // 1. Identify Material (cached per base form)
+        auto mat = Climb::Material::kStone;
+        if (surfaceRef) {
+            if (auto base = surfaceRef->GetBaseObject()) {
+                mat = Climb::SurfaceClass::GetMaterial(GetSurfaceClass(base));
             }
         }
+        auto soundDesc = descriptors[static_cast<std::size_t>(mat)];
+        if (!soundDesc) return;
+
+        // 2. Voice limiting / per-hand cooldown (only for a sound that will play)
+        const auto& settings = *Settings::GetSingleton()->activeSettings;
+        Climb::VoicePool::Params params;
+        params.maxVoices = settings.iMaxClimbVoices;
+        params.handCooldown = settings.fClimbSoundCooldown;
+        bool evict = false;
+        int slot = voicePool.Acquire(isLeft ? 0 : 1, NowSeconds(), params, evict);
+        if (slot < 0) return;
+
+        // 3. Play Sound on the pooled handle, at the grabbing hand
+        auto& handle = handles[slot];
+        if (evict) handle.Stop(); // The slot's previous voice, before the handle is rebuilt
+        auto audioMgr = RE::BSAudioManager::GetSingleton();
+        if (audioMgr && audioMgr->BuildSoundDataFromDescriptor(handle, soundDesc)) {
+            // Set volume slightly lower for hands compared to feet
+            handle.SetVolume(0.6f);
+            handle.SetPosition(handNode->world.translate);
+            handle.SetObjectToFollow(handNode);
+            handle.Play();
+        }
     }
 }
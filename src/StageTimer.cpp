@@ -0,0 +1,85 @@
+#include "StageTimer.h"
+#include <bit>
+
+using namespace Climb;
+
+const char* Climb::StageName(Stage stage) {
+    switch (stage) {
+    case Stage::kClimbMain: return "ClimbMain";
+    case Stage::kSpeedBuffer: return "SpeedBuffer";
+    case Stage::kCollision: return "Collision";
+    case Stage::kSolve: return "Solve";
+    case Stage::kHaptics: return "Haptics";
+    case Stage::kSound: return "Sound";
+    case Stage::kActorValues: return "ActorValues";
+    case Stage::kSetVelocity: return "SetVelocity";
+    default: return "?";
+    }
+}
+
+// 0-3 ns get a bucket each; above that, 4 buckets per power of two (the two bits below the top one)
+int LogHistogram::Bucket(std::uint64_t ns) {
+    if (ns < 4) return static_cast<int>(ns);
+    const int exponent = std::bit_width(ns) - 1;
+    const int sub = static_cast<int>((ns >> (exponent - 2)) & 3);
+    const int bucket = (exponent - 1) * 4 + sub;
+    return bucket < kBuckets ? bucket : kBuckets - 1;
+}
+
+std::uint64_t LogHistogram::BucketMid(int bucket) {
+    if (bucket < 4) return static_cast<std::uint64_t>(bucket);
+    const int exponent = bucket / 4 + 1;
+    const std::uint64_t width = std::uint64_t{1} << (exponent - 2);
+    const std::uint64_t low = static_cast<std::uint64_t>(4 + bucket % 4) * width;
+    return low + width / 2;
+}
+
+StageSummary LogHistogram::Summarize() const {
+    std::uint32_t snapshot[kBuckets];
+    std::uint64_t count = 0;
+    for (int b = 0; b < kBuckets; b++) {
+        snapshot[b] = counts[b].load(std::memory_order_relaxed);
+        count += snapshot[b];
+    }
+
+    StageSummary s;
+    s.count = count;
+    if (count == 0) return s;
+    s.maxNs = maxNs.load(std::memory_order_relaxed);
+    s.meanNs = static_cast<double>(sumNs.load(std::memory_order_relaxed)) / static_cast<double>(total.load(std::memory_order_relaxed));
+
+    // Nearest-rank percentiles
+    const std::uint64_t rank50 = (count * 50 + 99) / 100;
+    const std::uint64_t rank99 = (count * 99 + 99) / 100;
+    std::uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; b++) {
+        if (!snapshot[b]) continue;
+        const std::uint64_t before = seen;
+        seen += snapshot[b];
+        if (before < rank50 && seen >= rank50) s.p50Ns = BucketMid(b);
+        if (before < rank99 && seen >= rank99) {
+            s.p99Ns = BucketMid(b);
+            break;
+        }
+    }
+    // A midpoint can overshoot the largest sample in its bucket
+    if (s.p50Ns > s.maxNs) s.p50Ns = s.maxNs;
+    if (s.p99Ns > s.maxNs) s.p99Ns = s.maxNs;
+    return s;
+}
+
+void LogHistogram::Reset() {
+    for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    sumNs.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+}
+
+StageProfiler& StageProfiler::Get() {
+    static StageProfiler profiler;
+    return profiler;
+}
+
+void StageProfiler::Reset() {
+    for (auto& stage : stages) stage.Reset();
+}
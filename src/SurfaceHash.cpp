@@ -0,0 +1,104 @@
+#include "SurfaceHash.h"
+#include <bit>
+#include <cmath>
+
+using namespace Climb;
+
+void SurfaceHash::Reset(std::size_t capacity) {
+    slots.clear();
+    slots.shrink_to_fit();
+    mask = 0;
+    if (capacity == 0) return;
+    capacity = std::bit_ceil(capacity);
+    slots.resize(capacity);
+    mask = capacity - 1;
+}
+
+void SurfaceHash::Clear() {
+    for (auto& s : slots) s.used = false;
+}
+
+std::uint64_t SurfaceHash::KeyOf(const Vec3& p) {
+    // 21 bits per axis covers +-8M cells, far beyond any worldspace
+    auto q = [](float v) { return static_cast<std::uint64_t>(static_cast<std::int64_t>(std::floor(v / kCellSize))) & 0x1FFFFF; };
+    return (q(p.x) << 42) | (q(p.y) << 21) | q(p.z);
+}
+
+std::size_t SurfaceHash::IndexOf(std::uint64_t key) const {
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+SurfaceHash::Slot* SurfaceHash::Find(std::uint64_t key, std::uint32_t tick) {
+    std::size_t idx = IndexOf(key);
+    for (int i = 0; i < kProbeWindow; i++, idx = (idx + 1) & mask) {
+        auto& s = slots[idx];
+        if (s.used && s.key == key) {
+            return tick - s.lastUsed <= kMaxAge ? &s : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void SurfaceHash::Insert(const SurfaceSample& sample, std::uint32_t tick) {
+    if (slots.empty()) return;
+
+    const std::uint64_t key = KeyOf(sample.point);
+    std::size_t idx = IndexOf(key);
+    Slot* target = nullptr;
+    Slot* oldest = nullptr;
+    for (int i = 0; i < kProbeWindow; i++, idx = (idx + 1) & mask) {
+        auto& s = slots[idx];
+        if (!s.used || s.key == key) {
+            target = &s;
+            break;
+        }
+        if (!oldest || tick - s.lastUsed > tick - oldest->lastUsed) oldest = &s;
+    }
+    if (!target) {
+        target = oldest;
+        stats.evictions++;
+    }
+
+    target->used = true;
+    target->key = key;
+    target->lastUsed = tick;
+    target->sample = sample;
+    stats.inserts++;
+}
+
+SurfaceQueryHit SurfaceHash::Query(const Vec3& start, const Vec3& dir, float maxDist, std::uint32_t tick) {
+    SurfaceQueryHit result;
+    if (slots.empty()) return result;
+    stats.queries++;
+
+    // Half-cell steps so no cell along the ray is skipped
+    std::uint64_t lastKey = ~0ull;
+    for (float t = 0.0f; t <= maxDist + kCellSize; t += kCellSize * 0.5f) {
+        const std::uint64_t key = KeyOf(start + dir * t);
+        if (key == lastKey) continue;
+        lastKey = key;
+
+        Slot* s = Find(key, tick);
+        if (!s) continue;
+
+        const auto& sample = s->sample;
+        // Ray/plane intersection with the remembered surface
+        float denom = dir.x * sample.normal.x + dir.y * sample.normal.y + dir.z * sample.normal.z;
+        if (denom > -0.05f) continue;  // Parallel or facing away
+        Vec3 toPlane = sample.point - start;
+        float hitT = (toPlane.x * sample.normal.x + toPlane.y * sample.normal.y + toPlane.z * sample.normal.z) / denom;
+        if (hitT < 0.0f || hitT > maxDist) continue;
+        // Only trust the plane near where it was actually sampled
+        if ((start + dir * hitT - sample.point).SqrLength() > kCellSize * kCellSize * 4.0f) continue;
+
+        if (!sample.climbable) return result;  // Something unclimbable is in the way: let the real ray decide
+
+        s->lastUsed = tick;
+        result.hit = true;
+        result.distance = hitT;
+        result.sample = sample;
+        stats.answered++;
+        return result;
+    }
+    return result;
+}
@@ -1,4 +1,6 @@
 #include "Utils.h"
+#include "Sound.h"
+#include <chrono>
 #include <RE/H/hkpWorld.h> 
 #include <RE/H/hkpWorldRayCastOutput.h>
 #include <RE/T/TESHavokUtilities.h>
@@ -25,6 +27,7 @@ RE::NiPoint3 GetPlayerHandPos(bool isLeft, RE::Actor* player) {
     if (!playerCh) return RE::NiPoint3();
     
     auto vrData = playerCh->GetVRNodeData();
+    if (!vrData) return RE::NiPoint3();
     const auto weapon = isLeft ? vrData->NPCLHnd : vrData->NPCRHnd;
     const auto baseNode = vrData->UprightHmdNode;
 
@@ -36,170 +39,284 @@ RE::NiPoint3 GetPlayerHandPos(bool isLeft, RE::Actor* player) {
     return RE::NiPoint3();
 }
 
-RE::NiPoint3 Quad2Velo(RE::hkVector4& a_velocity) {
-    return RE::NiPoint3(a_velocity.quad.m128_f32[0], a_velocity.quad.m128_f32[1], a_velocity.quad.m128_f32[2]);
+namespace {
+    enum class HapticBackend { kNone, kVRIK, kGame };
+    HapticBackend hapticBackend{HapticBackend::kNone};
+    Climb::HapticQueue hapticQueue;
+}
+
+void ResolveHapticBackend() {
+    auto papyrusVM = RE::BSScript::Internal::VirtualMachine::GetSingleton();
+    hapticBackend = HapticBackend::kNone;
+    if (!papyrusVM) return;
+
+    const bool hasVRIK = papyrusVM->TypeIsValid("VRIK"sv);
+    const bool hasGame = papyrusVM->TypeIsValid("Game"sv);
+    const bool wantVRIK = Settings::GetSingleton()->activeSettings->bUseVRIKHaptics;
+    if (hasVRIK && (wantVRIK || !hasGame)) hapticBackend = HapticBackend::kVRIK;
+    else if (hasGame) hapticBackend = HapticBackend::kGame;
+
+    hapticQueue.Reset();
+    log::info("Haptics backend: {}", hapticBackend == HapticBackend::kVRIK   ? "VRIK.VrikHapticPulse"
+                                     : hapticBackend == HapticBackend::kGame ? "Game.ShakeController"
+                                                                             : "none");
 }
 
 void vibrateController(int hapticFrame, int length, bool isLeft) {
+    hapticQueue.Push(isLeft ? 0 : 1, hapticFrame, length);
+}
+
+void FlushHaptics() {
+    static const auto start = std::chrono::steady_clock::now();
+    auto flush = hapticQueue.Flush(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    if (!flush.Count() || hapticBackend == HapticBackend::kNone) return;
+
+    const float strength = Settings::GetSingleton()->activeSettings->fHapticStrength;
+    if (strength <= 0.0f) return;
     auto papyrusVM = RE::BSScript::Internal::VirtualMachine::GetSingleton();
     if (!papyrusVM) return;
 
     RE::BSTSmartPointer<RE::BSScript::IStackCallbackFunctor> callback;
 
-    if (papyrusVM->TypeIsValid("VRIK"sv)) {
-        int intensity = hapticFrame;
-        int dur = length;
-        auto args = RE::MakeFunctionArguments((bool)isLeft, (int)intensity, (int)dur);
-        papyrusVM->DispatchStaticCall("VRIK"sv, "VrikHapticPulse"sv, args, callback);
-
-    } else if (papyrusVM->TypeIsValid("Game"sv)) {
-        float normStrength = (float)hapticFrame / 100.0f;
-        if (normStrength > 1.0f) normStrength = 1.0f;
-        float durationSec = (float)length / 1000000.0f;
-        
-        if (isLeft) {
-             float leftInt = normStrength; float rightInt = 0.0f; float dur = durationSec;
-             auto args = RE::MakeFunctionArguments((float)leftInt, (float)rightInt, (float)dur);
-             papyrusVM->DispatchStaticCall("Game"sv, "ShakeController"sv, args, callback);
-        } else {
-             float leftInt = 0.0f; float rightInt = normStrength; float dur = durationSec;
-             auto args = RE::MakeFunctionArguments((float)leftInt, (float)rightInt, (float)dur);
-             papyrusVM->DispatchStaticCall("Game"sv, "ShakeController"sv, args, callback);
+    if (hapticBackend == HapticBackend::kVRIK) {
+        for (int hand = 0; hand < 2; hand++) {
+            if (!flush.ready[hand]) continue;
+            // VRIK only takes whole intensities; keep the weakest pulse alive
+            int intensity = std::max(1, (int)std::lround(flush.pulse[hand].intensity * strength));
+            auto args = RE::MakeFunctionArguments((bool)(hand == 0), (int)intensity, (int)flush.pulse[hand].lengthUs);
+            papyrusVM->DispatchStaticCall("VRIK"sv, "VrikHapticPulse"sv, args, callback);
+            hapticQueue.CountDispatch(false);
+            CLIMB_TRACE_INSTANT("HapticPulse", hand);
         }
+        return;
+    }
+
+    auto norm = [&](int hand) {
+        if (!flush.ready[hand]) return 0.0f;
+        return std::min(1.0f, (float)flush.pulse[hand].intensity / 100.0f * strength);
+    };
+    if (flush.Shared()) {
+        auto args = RE::MakeFunctionArguments(norm(0), norm(1), (float)flush.pulse[0].lengthUs / 1000000.0f);
+        papyrusVM->DispatchStaticCall("Game"sv, "ShakeController"sv, args, callback);
+        hapticQueue.CountDispatch(true);
+        CLIMB_TRACE_INSTANT("HapticPulse", 2);  // Both hands
+        return;
+    }
+    for (int hand = 0; hand < 2; hand++) {
+        if (!flush.ready[hand]) continue;
+        float leftInt = hand == 0 ? norm(0) : 0.0f;
+        float rightInt = hand == 1 ? norm(1) : 0.0f;
+        auto args = RE::MakeFunctionArguments((float)leftInt, (float)rightInt, (float)flush.pulse[hand].lengthUs / 1000000.0f);
+        papyrusVM->DispatchStaticCall("Game"sv, "ShakeController"sv, args, callback);
+        hapticQueue.CountDispatch(false);
+        CLIMB_TRACE_INSTANT("HapticPulse", hand);
     }
 }
 
+const Climb::HapticStats& GetHapticStats() { return hapticQueue.Stats(); }
+void ResetHapticStats() { hapticQueue.ResetStats(); }
+
+void LogStageTimings(bool toConsole) {
+#ifdef FREECLIMB_PROFILE
+    const auto& profiler = Climb::StageProfiler::Get();
+    auto console = toConsole ? RE::ConsoleLog::GetSingleton() : nullptr;
+    log::info("Stage timings (us): p50 / p99 / max / mean over N calls");
+    for (int i = 0; i < static_cast<int>(Climb::Stage::kCount); i++) {
+        const auto stage = static_cast<Climb::Stage>(i);
+        const auto s = profiler.Summarize(stage);
+        if (!s.count) continue;
+        const auto line = std::format("{:<12} {:8.2f} {:8.2f} {:8.2f} {:8.2f}  N={}", Climb::StageName(stage), s.p50Ns / 1000.0,
+                                      s.p99Ns / 1000.0, s.maxNs / 1000.0, s.meanNs / 1000.0, s.count);
+        log::info("{}", line);
+        if (console) console->Print("FreeClimbVR %s", line.c_str());
+    }
+#else
+    (void)toConsole;
+#endif
+}
+
 // WHITELIST HELPER
-bool IsWhitelisted(RE::FormType t) {
-    return t == RE::FormType::Static || 
-           t == RE::FormType::MovableStatic ||
-           t == RE::FormType::Tree ||
-           t == RE::FormType::Flora ||
-           t == RE::FormType::Furniture || 
-           t == RE::FormType::Door ||
-           t == RE::FormType::Activator ||
-           t == RE::FormType::Container;
+bool IsWhitelisted(RE::FormType t) { return Climb::SurfaceClass::IsClimbableFormType(t); }
+
+namespace {
+    enum class HitVerdict { kIgnore, kRejected, kAccepted };
+
+    // Applies the layer blacklist and reference whitelist to a ray hit.
+    // kRejected = a real surface that must not be climbed (remembered by the surface hash).
+    HitVerdict ResolveHit(const RE::hkpWorldRayCastOutput& output, ClimbHitData& result) {
+        const auto collidable = output.rootCollidable;
+        if (!collidable) return HitVerdict::kIgnore;
+
+        auto layer = collidable->broadPhaseHandle.collisionFilterInfo & 0x7F;
+        if (Climb::SurfaceClass::IsBlacklistedLayer(layer)) return HitVerdict::kIgnore;
+        if (output.hitFraction < 0.01f) return HitVerdict::kIgnore;
+
+        result.layer = layer;
+        result.normal.x = output.normal.quad.m128_f32[0];
+        result.normal.y = output.normal.quad.m128_f32[1];
+        result.normal.z = output.normal.quad.m128_f32[2];
+        result.refr = RE::TESHavokUtilities::FindCollidableRef(*collidable);
+        result.formID = result.refr ? result.refr->formID : 0;
+
+        // STRICT WHITELIST
+        if (result.refr) {
+            if (result.refr->formID == 0x14) return HitVerdict::kIgnore; // Self Grab Prevention
+
+            auto base = result.refr->GetBaseObject();
+            if (base && !Climb::SurfaceClass::IsWhitelisted(GetSurfaceClass(base))) return HitVerdict::kRejected;
+        } else {
+            // BLOCK NULL REF if not Static/AnimStatic
+            if (!Climb::SurfaceClass::IsUnownedClimbableLayer(layer)) return HitVerdict::kRejected;
+        }
+
+        result.hit = true;
+        return HitVerdict::kAccepted;
+    }
 }
 
 // Raycast Collision Check (v2.3 Target Layer 56 Fix)
-ClimbHitData CheckClimbCollision(RE::Actor* player, bool isLeft, float rayDist) {
-     ClimbHitData result;
-     result.hit = false;
-     
-     auto playerCh = RE::PlayerCharacter::GetSingleton();
-     if (!playerCh) return result;
-     
-     auto vrData = playerCh->GetVRNodeData();
-     auto handNode = isLeft ? vrData->NPCLHnd : vrData->NPCRHnd;
-     if (!handNode) return result;
-     
-     RE::NiMatrix3 rotation = handNode->world.rotate;
-     RE::NiPoint3 forward = {rotation.entry[0][1], rotation.entry[1][1], rotation.entry[2][1]}; 
-     RE::NiPoint3 right = {rotation.entry[0][0], rotation.entry[1][0], rotation.entry[2][0]}; 
-     RE::NiPoint3 up = {rotation.entry[0][2], rotation.entry[1][2], rotation.entry[2][2]}; 
-     RE::NiPoint3 dirDown = (forward - up); dirDown.Unitize();
-     
-     struct RayDir { RE::NiPoint3 dir; float maxDist; };
-     RayDir rays[] = {
-         { forward, rayDist },              
-         { dirDown, rayDist * 0.8f },       
-     };
-
-     float startOffset = 2.0f; 
-     RE::NiPoint3 baseStart = handNode->world.translate + (forward * startOffset);
-
-     RE::bhkWorld* world = player->GetParentCell()->GetbhkWorld();
-     if (!world) return result;
-     
-     const float havokScale = 0.0142875f;
-     auto hkWorld = world->GetWorld1();
-     if (!hkWorld) return result;
-
-     for (const auto& ray : rays) {
-         RE::NiPoint3 rStart = baseStart;
-         RE::NiPoint3 rEnd = rStart + (ray.dir * ray.maxDist);
-         
-         RE::hkpWorldRayCastInput input;
-         input.from = {rStart.x * havokScale, rStart.y * havokScale, rStart.z * havokScale, 0.0f}; 
-         input.to = {rEnd.x * havokScale, rEnd.y * havokScale, rEnd.z * havokScale, 0.0f};
-         
-         RE::hkpWorldRayCastOutput output;
-         hkWorld->CastRay(input, output);
-         
-         if (output.HasHit()) {
-             const auto collidable = output.rootCollidable;
-             if (collidable) {
-                 auto& broadphase = collidable->broadPhaseHandle;
-                 auto layer = broadphase.collisionFilterInfo & 0x7F; 
-                 
-                 // BLACKLIST
-                 // 5=Weapon, 6=Projectile, 8=Biped, 32=CharController
-                 // 56 = Custom Physics Layer detected in User Log (Pseudo Physics Weapon)
-                 // Also blocking 57, 58 just in case.
-                 if (layer == 5 || layer == 6 || layer == 8 || layer == 32 || layer >= 56) {
-                     continue; 
-                 }
-                    
-                 if (output.hitFraction < 0.01f) continue;
-                 
-                 result.hit = true;
-                 result.normal.x = output.normal.quad.m128_f32[0];
-                 result.normal.y = output.normal.quad.m128_f32[1];
-                 result.normal.z = output.normal.quad.m128_f32[2];
-                 
-                 result.refr = RE::TESHavokUtilities::FindCollidableRef(*collidable);
-                 
-                 // STRICT WHITELIST
-                 if (result.refr) {
-                     if (result.refr->formID == 0x14) continue; 
-                     
-                     auto base = result.refr->GetBaseObject();
-                     if (base) {
-                         if (!IsWhitelisted(base->GetFormType())) {
-                             result.hit = false; result.refr = nullptr; continue;
-                         }
-                     }
-                 } else {
-                     // BLOCK NULL REF if not Static/AnimStatic
-                     if (layer != 1 && layer != 2 && layer != 3 && layer != 13) {
-                         continue;
-                     }
-                 }
-                 
-                 return result; 
-             }
-         }
-     }
-     
-     return result;
+// Rays for both hands are set up in one batch (see RayFan.h); each hand takes the first
+// acceptable hit in priority order, exactly like the old two-ray loop.
+void CheckClimbCollision(const EngineHandles& handles, const bool probe[2], const Climb::HandInput hands[2],
+                         float rayDist, Climb::RayFanPlanner& planner, Climb::SurfaceHash* surfaces, ClimbHitData out[2]) {
+    const auto& settings = *Settings::GetSingleton()->activeSettings;
+    out[0] = {};
+    out[1] = {};
+
+    Climb::HandRayPose poses[2];
+    Climb::ProbeMode modes[2] = {Climb::ProbeMode::kNone, Climb::ProbeMode::kNone};
+    for (int hand = 0; hand < 2; hand++) {
+        auto handNode = handles.VRHand(hand);
+        if (!probe[hand] || !handNode) continue;
+
+        const RE::NiMatrix3& rotation = handNode->world.rotate;
+        poses[hand].translate = hands[hand].position;
+        poses[hand].right = {rotation.entry[0][0], rotation.entry[1][0], rotation.entry[2][0]};
+        poses[hand].forward = {rotation.entry[0][1], rotation.entry[1][1], rotation.entry[2][1]};
+        poses[hand].up = {rotation.entry[0][2], rotation.entry[1][2], rotation.entry[2][2]};
+        if (hands[hand].gripping) {
+            // Speed buffer velocity back in units/s
+            poses[hand].sweep = hands[hand].velocity * (settings.fGrabLookAhead * 0.001f / Climb::kSolverVelocityScale);
+        }
+        modes[hand] = planner.Plan(hand, hands[hand].gripping, settings.bAdaptiveRays);
+    }
+    if (modes[0] == Climb::ProbeMode::kNone && modes[1] == Climb::ProbeMode::kNone) return;
+
+    // No world during cell transitions
+    auto hkWorld = handles.World();
+    if (!hkWorld) return;
+
+    Climb::RayBatch batch;
+    Climb::BuildRayBatch(poses, modes, rayDist, settings.iRayFanSize, batch);
+
+    int raysCast = 0;
+    int sweepsCast = 0;
+    for (int hand = 0; hand < 2; hand++) {
+        float nearest = -1.0f;
+        for (int i = 0; i < batch.count[hand]; i++) {
+            const int n = batch.first[hand] + i;
+
+            RE::hkpWorldRayCastInput input;
+            input.from.quad = _mm_load_ps(batch.from[n]);
+            input.to.quad = _mm_load_ps(batch.to[n]);
+
+            RE::hkpWorldRayCastOutput output;
+            {
+                CLIMB_TRACE_SPAN("CastRay", hand);
+                hkWorld->CastRay(input, output);
+            }
+            raysCast++;
+            if (batch.predicted[n]) sweepsCast++;
+
+            if (!output.HasHit()) continue;
+
+            ClimbHitData result;
+            auto verdict = ResolveHit(output, result);
+            if (verdict == HitVerdict::kIgnore) continue;
+
+            result.distance = output.hitFraction * batch.length[n];
+            const float f = output.hitFraction / Climb::kHavokScale;
+            result.point.x = batch.from[n][0] / Climb::kHavokScale + (batch.to[n][0] - batch.from[n][0]) * f;
+            result.point.y = batch.from[n][1] / Climb::kHavokScale + (batch.to[n][1] - batch.from[n][1]) * f;
+            result.point.z = batch.from[n][2] / Climb::kHavokScale + (batch.to[n][2] - batch.from[n][2]) * f;
+
+            if (surfaces) {
+                Climb::SurfaceSample sample;
+                sample.point = ToVec3(result.point);
+                sample.normal = ToVec3(result.normal);
+                sample.refrFormID = result.formID;
+                sample.layer = static_cast<std::uint8_t>(result.layer);
+                sample.climbable = verdict == HitVerdict::kAccepted;
+                surfaces->Insert(sample, static_cast<std::uint32_t>(iFrameCount));
+            }
+            if (verdict != HitVerdict::kAccepted) continue;
+
+            result.predicted = batch.predicted[n];
+            if (!result.predicted && (nearest < 0.0f || result.distance < nearest)) nearest = result.distance;
+
+            // Probe rays reach past fRayDist to sense an approaching surface; that only counts as "near"
+            if (result.distance <= batch.grabDist[n]) {
+                out[hand] = result;
+                break;
+            }
+        }
+        if (modes[hand] != Climb::ProbeMode::kNone) planner.Report(hand, nearest, rayDist);
+    }
+    planner.CountFrame(modes, raysCast, sweepsCast);
+}
+
+namespace {
+    Climb::FormClassCache surfaceClassCache;
+
+    // IsClimbingTool verdict per hand, recomputed only when the equipped object changes
+    struct ToolCache {
+        RE::TESForm* equipped{nullptr};
+        bool isTool{false};
+    };
+    ToolCache toolCache[2];
+
+    bool NameHasIce(RE::TESBoundObject* base) {
+        const char* name = base->GetName();
+        return name && Climb::SurfaceClass::NameHasIce(name);
+    }
+}
+
+std::uint8_t GetSurfaceClass(RE::TESBoundObject* base) {
+    std::uint8_t cls;
+    if (surfaceClassCache.Find(base->formID, cls)) return cls;
+
+    cls = Climb::SurfaceClass::Pack(IsWhitelisted(base->GetFormType()), NameHasIce(base), Sound::PredictMaterial(base));
+    surfaceClassCache.Insert(base->formID, cls);
+    return cls;
+}
+
+void ResetSurfaceClassCache() {
+    surfaceClassCache.Clear();
+    toolCache[0] = {};
+    toolCache[1] = {};
 }
 
 bool IsIce(RE::TESObjectREFR* ref) {
     if (!ref) return false;
     auto base = ref->GetBaseObject();
     if (!base) return false;
-    const char* name = base->GetName();
-    if (name) {
-        std::string n = name;
-        if (n.find("Ice") != std::string::npos || n.find("Glacier") != std::string::npos || n.find("Frozen") != std::string::npos) {
-            return true;
-        }
-    }
-    return false;
+    return Climb::SurfaceClass::IsIce(GetSurfaceClass(base));
 }
 
 bool IsClimbingTool(RE::Actor* player, bool isLeft) {
     if (!player) return false;
     auto obj = player->GetEquippedObject(isLeft);
-    if (!obj) return false;
-    if (obj->Is(RE::FormType::Weapon)) {
-        auto weap = obj->As<RE::TESObjectWEAP>();
-        if (!weap) return false;
-        auto type = weap->GetWeaponType();
-        using WType = RE::WEAPON_TYPE;
-        if (type == WType::kOneHandAxe || type == WType::kOneHandDagger || type == WType::kOneHandMace) {
-            return true;
+    auto& cached = toolCache[isLeft ? 0 : 1];
+    if (obj == cached.equipped) return cached.isTool;
+
+    bool isTool = false;
+    if (obj && obj->Is(RE::FormType::Weapon)) {
+        if (auto weap = obj->As<RE::TESObjectWEAP>()) {
+            auto type = weap->GetWeaponType();
+            using WType = RE::WEAPON_TYPE;
+            isTool = type == WType::kOneHandAxe || type == WType::kOneHandDagger || type == WType::kOneHandMace;
         }
     }
-    return false;
+    cached = {obj, isTool};
+    return isTool;
 }
@@ -0,0 +1,889 @@
+// Headless behaviour checks for the core: grip input, kinematics, settings, materials, voices,
+// profiling, traces, ray planning, SIMD math and the frame -> physics handoff.
+// Usage: ClimbTests [check...]
+// Runs the named checks (all of them without arguments), prints one line per check and exits 1
+// if any fails. CTest registers each check as its own test.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ClimbSolver.h"
+#include "FrameTrace.h"
+#include "RayFan.h"
+#include "MaterialMatcher.h"
+#include "VoicePool.h"
+#include "GripState.h"
+#include "KinematicsRing.h"
+#include "MotionFilter.h"
+#include "SettingsSchema.h"
+#include "StageTimer.h"
+#include "EventTrace.h"
+#include "LogLimiter.h"
+#include "SyntheticClimb.h"
+#include "VelocityPipeline.h"
+#include "ClimberPool.h"
+#include "VelocityCommand.h"
+#include "BenchCommon.h"
+
+namespace {
+    bool CheckRefreshRates() {
+        const ClimbingSettings settings;
+        const double checkAt[] = {0.50, 0.93, 1.37, 1.81};
+        float worst[2] = {0.0f, 0.0f};
+        float legacyRatio = 0.0f;
+        for (int est = 0; est < 2; est++) {
+            const float window = est ? 0.05f : settings.fVelocityWindow;
+            for (double at : checkAt) {
+                Climb::Vec3 v[2];
+                Climb::Vec3 legacy[2];
+                const double rates[2] = {90.0, 144.0};
+                for (int r = 0; r < 2; r++) {
+                    Climb::KinematicsRing ring;
+                    Bench::LegacySpeedRing old(100);
+                    // Frame times with +-3% jitter, ending exactly at the check time
+                    const int frames = static_cast<int>(at * rates[r]);
+                    for (int f = frames; f >= 0; f--) {
+                        double t = at - f / rates[r] + (f ? 0.03 / rates[r] * std::sin(f * 1.3) : 0.0);
+                        ring.Push(Bench::CurvePos(t), t);
+                        old.Push(Bench::CurvePos(t));
+                    }
+                    v[r] = ring.Velocity(static_cast<Climb::VelocityEstimator>(est), window) * Climb::kSolverVelocityScale;
+                    legacy[r] = old.GetVelocity(3);
+                }
+                float err = (v[0] - v[1]).Length() / (v[0].Length() > 1e-4f ? v[0].Length() : 1e-4f);
+                if (err > worst[est]) worst[est] = err;
+                if (legacy[1].Length() > 1e-4f) legacyRatio = legacy[0].Length() / legacy[1].Length();
+            }
+        }
+        // The estimators see different sample sets at each rate; a few % is sampling, not scale
+        const bool ok = worst[0] < 0.05f && worst[1] < 0.05f;
+        std::printf("KinematicsRing  %s  90 vs 144 Hz velocity differs by %.2f%% (line fit), %.2f%% (Savitzky-Golay); "
+                    "legacy ring: %.2fx\n",
+                    ok ? "ok" : "FAILED", worst[0] * 100.0f, worst[1] * 100.0f, legacyRatio);
+        return ok;
+    }
+
+    // Grip input check: scripted event lists per 90 Hz frame, polled once per frame like ClimbMain.
+    // The release must be seen on the frame its event arrives, a pause in repeat events must not
+    // drop the grip, a reset must free a hand whose release never came, and the old 100 ms
+    // timeout model is run alongside for comparison.
+    bool CheckGripEdges() {
+        constexpr int kFrames = 60;
+        constexpr std::int64_t kFrameNs = 1000000000 / 90;
+        std::vector<Climb::GripEvent> events[kFrames];
+        events[2].push_back({1, 2, 1.0f});              // Left press
+        for (int f = 3; f < 8; f++) events[f].push_back({1, 2, 1.0f});  // Repeats, then a 200 ms gap
+        events[5].push_back({1, 33, 1.0f});             // Duplicate ID, ignored
+        events[30].push_back({1, 2, 0.0f});             // Left release
+        events[40].push_back({5, 2, 1.0f});             // Right tap on an alternate device number,
+        events[40].push_back({5, 2, 0.0f});             // pressed and released within one frame
+        events[50].push_back({3, 2, 1.0f});             // Unmapped device
+
+        Climb::GripDecoder decoder;
+        Climb::GripChannel channels[2];
+        std::uint32_t seen[2]{};
+        std::int64_t legacyLast[2] = {-1000000000, -1000000000};
+        bool ok = true;
+        int legacyReleaseFrame = -1;
+        int legacyDropped = 0;
+        for (int f = 0; f < kFrames; f++) {
+            const std::int64_t now = f * kFrameNs;
+            for (const auto& ev : events[f]) {
+                int hand = decoder.Decode(ev);
+                if (hand < 0) continue;
+                channels[hand].Apply(ev.Pressed(), now);
+                legacyLast[hand] = now;  // Old InputManager: any grip event refreshed the timestamp
+            }
+            const bool left = channels[0].Poll(seen[0]);
+            const bool right = channels[1].Poll(seen[1]);
+            const bool wantLeft = f >= 2 && f < 30;
+            const bool wantRight = f == 40;
+            if (left != wantLeft || right != wantRight) {
+                std::printf("GripChannel  frame %d: left %d (want %d) right %d (want %d)\n", f, left, wantLeft, right,
+                            wantRight);
+                ok = false;
+            }
+            if (wantLeft && now - legacyLast[0] >= 100000000) legacyDropped++;
+            if (f >= 30 && legacyReleaseFrame < 0 && now - legacyLast[0] >= 100000000) legacyReleaseFrame = f;
+        }
+        if (channels[0].PressedAt() != 2 * kFrameNs) ok = false;
+
+        // Lost release (menu, load): after Reset the hand is free and an earlier tap does not grab
+        channels[1].Apply(true, kFrames * kFrameNs);
+        channels[1].Reset();
+        channels[1].Poll(seen[1]);
+        if (channels[1].IsDown() || channels[1].Poll(seen[1]) || channels[1].PressedAt() != 0) ok = false;
+        std::printf("GripChannel  %s  release seen after 0 frames (legacy 100 ms timeout: %d frames late at 90 Hz, "
+                    "%d held frames dropped)\n",
+                    ok ? "ok" : "FAILED", legacyReleaseFrame - 30, legacyDropped);
+        return ok;
+    }
+
+    // Material matcher: overlapping patterns resolve by rank through the failure links, the
+    // default table agrees with a plain substring search over generated names, patterns are
+    // case-sensitive like the old name checks, keywords decide before the name, and a pattern
+    // list past 64K automaton nodes still matches.
+    bool CheckMaterialMatcher() {
+        using Climb::Material;
+        bool ok = true;
+        auto matches = [](const Climb::MaterialMatcher& m, std::string_view text, Material want) {
+            Material got = Material::kStone;
+            return m.Match(text, got) && got == want;
+        };
+        auto misses = [](const Climb::MaterialMatcher& m, std::string_view text) {
+            Material got;
+            return !m.Match(text, got);
+        };
+
+        Climb::MaterialMatcher overlap;
+        overlap.AddPattern("he", Material::kDirt);
+        overlap.AddPattern("she", Material::kMetal);
+        overlap.AddPattern("hers", Material::kWood);
+        overlap.AddPattern("his", Material::kSnow);
+        overlap.Build();
+        ok &= matches(overlap, "ushers", Material::kWood) && matches(overlap, "ushe", Material::kMetal) &&
+              matches(overlap, "ahe", Material::kDirt) && matches(overlap, "this", Material::kSnow) && misses(overlap, "hi");
+
+        // Default table vs the old one-pattern-at-a-time search, lowest rank winning
+        const auto defaults = Climb::MaterialMatcher::Defaults();
+        const Material order[] = {Material::kWood, Material::kSnow, Material::kMetal, Material::kDirt};
+        auto naive = [&](const std::string& text, Material& out) {
+            for (auto mat : order) {
+                std::string_view list = Climb::MaterialMatcher::DefaultPatterns(mat);
+                while (!list.empty()) {
+                    auto comma = list.find(',');
+                    auto item = list.substr(0, comma);
+                    while (!item.empty() && item.front() == ' ') item.remove_prefix(1);
+                    if (text.find(item) != std::string::npos) {
+                        out = mat;
+                        return true;
+                    }
+                    if (comma == std::string_view::npos) break;
+                    list.remove_prefix(comma + 1);
+                }
+            }
+            return false;
+        };
+        const char* pieces[] = {"Wo", "od", "Ir", "on", "Ice", "Fro", "zen", "Dw", "arven", "Lo", "g", "Sn", "ow", " ", "Grass", "Soi", "l"};
+        std::uint32_t seed = 4242;
+        int disagreements = 0;
+        for (int i = 0; i < 20000; i++) {
+            std::string text;
+            for (int n = 0; n < 6; n++) {
+                seed = seed * 1664525u + 1013904223u;
+                text += pieces[(seed >> 8) % std::size(pieces)];
+            }
+            Material a = Material::kStone, b = Material::kStone;
+            const bool hitA = defaults.Match(text, a), hitB = naive(text, b);
+            disagreements += hitA != hitB || (hitA && a != b);
+        }
+        ok &= disagreements == 0;
+
+        ok &= matches(defaults, "Wooden Plank Floor", Material::kWood) && misses(defaults, "wooden crate") &&
+              misses(defaults, "WOOD") && matches(defaults, "Frozen wood", Material::kSnow);
+
+        auto surface = [&](std::vector<const char*> keywords, const char* name, Material want) {
+            Material got = Material::kStone;
+            const bool hit = defaults.MatchSurface(static_cast<std::uint32_t>(keywords.size()),
+                                                   [&](std::uint32_t i) { return keywords[i]; }, name, got);
+            return hit && got == want;
+        };
+        ok &= surface({"LocTypeDungeon", "MaterialWood"}, "Iron Gate", Material::kWood);    // Keyword beats name
+        ok &= surface({"ArmorMaterialIron", "MaterialWood"}, "Pine", Material::kMetal);     // First keyword, not best rank
+        ok &= surface({nullptr, "LocTypeDungeon"}, "Iron Gate", Material::kMetal);          // Name when no keyword matches
+        Material none = Material::kStone;
+        ok &= !defaults.MatchSurface(0, [](std::uint32_t) -> const char* { return nullptr; }, nullptr, none);
+
+        // 20000 six-letter patterns: ~100K nodes, past what 16-bit transitions could address
+        Climb::MaterialMatcher large;
+        std::string last;
+        for (std::uint32_t n = 0; n < 20000; n++) {
+            std::string p;
+            for (std::uint32_t v = n * 7919 + 1, k = 0; k < 6; k++, v /= 26) p += static_cast<char>('a' + v % 26);
+            large.AddPattern(p, n % 2 ? Material::kMetal : Material::kDirt);
+            last = p;
+        }
+        large.AddPattern("zzzzzzzq", Material::kWood);
+        large.Build();
+        ok &= matches(large, "__" + last + "__", Material::kMetal) && matches(large, "xzzzzzzzq", Material::kWood);
+
+        std::printf("MaterialMatcher  %s  overlap/precedence/case checks, %d disagreements with substring search over "
+                    "20000 names, %zu-pattern list\n",
+                    ok ? "ok" : "FAILED", disagreements, large.PatternCount());
+        return ok;
+    }
+
+    // Climb sound voices: per-hand cooldown, free slots before busy ones, the oldest busy voice
+    // stolen when all are busy, and every reuse of a slot that held a voice flagged for Stop().
+    bool CheckVoicePool() {
+        Climb::VoicePool pool;
+        Climb::VoicePool::Params params;  // 4 voices, 0.6 s busy, 0.12 s per hand
+        bool evict = true;
+        bool ok = pool.Acquire(0, 0.00f, params, evict) == 0 && !evict;
+        ok &= pool.Acquire(0, 0.05f, params, evict) == -1;                    // Same hand, cooling down
+        ok &= pool.Acquire(1, 0.05f, params, evict) == 1 && !evict;           // Other hand is free to play
+        ok &= pool.Acquire(0, 0.20f, params, evict) == 2 && !evict;
+        ok &= pool.Acquire(1, 0.25f, params, evict) == 3 && !evict;
+        ok &= pool.Acquire(0, 0.40f, params, evict) == 0 && evict && pool.Stolen() == 1;  // All busy: oldest
+        ok &= pool.Acquire(1, 0.45f, params, evict) == 1 && evict && pool.Stolen() == 2;  // Next oldest
+        // Past voiceSeconds a slot is free again, but its sound may still be ringing
+        ok &= pool.Acquire(0, 0.90f, params, evict) == 2 && evict && pool.Stolen() == 2;
+
+        pool.Reset();
+        ok &= pool.Acquire(0, 0.0f, params, evict) == 0 && !evict && pool.Stolen() == 0;
+
+        // maxVoices is clamped to [1, kMaxVoices]
+        Climb::VoicePool clamp;
+        params.maxVoices = 0;
+        params.handCooldown = 0.0f;
+        ok &= clamp.Acquire(0, 0.0f, params, evict) == 0 && clamp.Acquire(0, 0.1f, params, evict) == 0 && evict;
+        params.maxVoices = 100;
+        int highest = 0;
+        for (int i = 0; i < 20; i++) highest = std::max(highest, clamp.Acquire(i & 1, 0.2f + i * 0.01f, params, evict));
+        ok &= highest == Climb::VoicePool::kMaxVoices - 1;
+
+        std::printf("VoicePool  %s  cooldown, free-slot, oldest-steal and eviction checks\n", ok ? "ok" : "FAILED");
+        return ok;
+    }
+
+    // Settings schema: out-of-range and NaN INI values are clamped, and the derived block follows
+    bool CheckSettingsSchema() {
+        ClimbingSettings s;
+        const auto* arm = Climb::FindSetting("FMAXARMLENGTH");
+        const auto* fan = Climb::FindSetting("iRayFanSize");
+        const auto* smoothing = Climb::FindSetting("fMotionSmoothing");
+        bool ok = arm && fan && smoothing && !Climb::FindSetting("fMaxArmLen");
+        if (ok) {
+            arm->Set(s, 5000.0);
+            fan->Set(s, 2.0);
+            smoothing->Set(s, std::nan(""));
+            ok = Climb::ClampSetting(*arm, s) && Climb::ClampSetting(*fan, s) && Climb::ClampSetting(*smoothing, s);
+            ok = ok && s.fMaxArmLength == 1000.0f && s.iRayFanSize == 5 && s.fMotionSmoothing == 0.4f;
+            s.fMotionSmoothing = 0.0f;
+            Climb::UpdateDerived(s);
+            ok = ok && s.derived.maxArmLengthSq == 1000.0f * 1000.0f && s.derived.motionAlpha == 0.01f;
+        }
+        std::printf("SettingsSchema  %s  (%zu keys)\n", ok ? "ok" : "FAILED", std::size(Climb::kClimbingFields));
+        return ok;
+    }
+
+    // Stage timer histograms: bucket edges, percentiles of a known distribution (within one bucket,
+    // about 19%), no samples lost when four threads record at once, and the cost of one scoped timer.
+    bool CheckStageTimer() {
+        bool ok = true;
+        for (std::uint64_t ns = 1; ns < (std::uint64_t{1} << 32); ns = ns * 3 / 2 + 1) {
+            const int b = Climb::LogHistogram::Bucket(ns);
+            const auto mid = Climb::LogHistogram::BucketMid(b);
+            if (b < Climb::LogHistogram::Bucket(ns / 2) || (mid > ns ? mid - ns : ns - mid) > ns / 8 + 1) ok = false;
+        }
+
+        // 1..10000 ns uniform: p50 ~5000, p99 ~9900
+        Climb::LogHistogram uniform;
+        for (std::uint64_t ns = 1; ns <= 10000; ns++) uniform.Record(ns);
+        const auto u = uniform.Summarize();
+        auto near = [](std::uint64_t got, double want) { return got > want * 0.85 && got < want * 1.15; };
+        ok &= u.count == 10000 && u.maxNs == 10000 && near(u.p50Ns, 5000) && near(u.p99Ns, 9900);
+
+        Climb::StageProfiler profiler;
+        constexpr int kThreads = 4;
+        constexpr int kPerThread = 200000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; t++) {
+            threads.emplace_back([&profiler, t] {
+                for (int i = 0; i < kPerThread; i++) profiler.Record(Climb::Stage::kSetVelocity, 100 + (i % 1000) + t);
+            });
+        }
+        for (auto& t : threads) t.join();
+        const auto mt = profiler.Summarize(Climb::Stage::kSetVelocity);
+        ok &= mt.count == std::uint64_t{kThreads} * kPerThread && mt.maxNs == 1099 + kThreads - 1;
+
+        profiler.Reset();
+        constexpr int kTimed = 1000000;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kTimed; i++) {
+            Climb::ScopedStageTimer timer(Climb::Stage::kSolve, profiler);
+        }
+        const double timerNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / kTimed;
+        const auto self = profiler.Summarize(Climb::Stage::kSolve);
+        ok &= self.count == kTimed;
+
+        std::printf("StageTimer  %s  uniform p50 %llu p99 %llu ns, %d threads x %d samples, scoped timer %.1f ns "
+                    "(p50 %llu ns inside)\n",
+                    ok ? "ok" : "FAILED", (unsigned long long)u.p50Ns, (unsigned long long)u.p99Ns, kThreads, kPerThread,
+                    timerNs, (unsigned long long)self.p50Ns);
+        return ok;
+    }
+
+    // Event trace: a frame thread and a "physics" thread record at once; every event must reach the
+    // JSON file (nothing dropped at this rate), each with its own thread ID, and the file must close.
+    bool CheckEventTrace() {
+        auto& tracer = Climb::EventTracer::Get();
+        const auto path = (std::filesystem::temp_directory_path() / "ClimbTests_Events.json").string();
+        if (!tracer.Start(path.c_str(), std::chrono::milliseconds(20))) {
+            std::printf("EventTrace  FAILED  can't create %s\n", path.c_str());
+            return false;
+        }
+
+        constexpr int kFrames = 2000;
+        std::atomic<bool> running{true};
+        std::thread physics([&] {
+            while (running.load()) {
+                { Climb::ScopedStageTimer timer(Climb::Stage::kSetVelocity); }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));  // A few calls per frame, like the proxy controller
+            }
+        });
+        std::chrono::steady_clock::duration paused{};
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int f = 0; f < kFrames; f++) {
+            if (f % 200 == 0) {
+                // Let the flusher run mid-session (not counted in the per-frame cost)
+                const auto p0 = std::chrono::steady_clock::now();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                paused += std::chrono::steady_clock::now() - p0;
+            }
+            Climb::ScopedTraceSpan frame("OnFrameUpdate");
+            Climb::ScopedStageTimer climb(Climb::Stage::kClimbMain);
+            for (int hand = 0; hand < 2; hand++) Climb::ScopedTraceSpan ray("CastRay", hand);
+            if (f % 100 == 0) tracer.Instant("Grab", f % 2);
+        }
+        const double frameNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0 - paused).count() / kFrames;
+        running = false;
+        physics.join();
+        tracer.Stop();
+        Climb::StageProfiler::Get().Reset();
+
+        std::string json;
+        if (auto f = std::fopen(path.c_str(), "rb")) {
+            char chunk[65536];
+            for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) > 0;) json.append(chunk, n);
+            std::fclose(f);
+        }
+        std::size_t events = 0, frames = 0;
+        for (auto at = json.find("\"ph\":"); at != std::string::npos; at = json.find("\"ph\":", at + 1)) events++;
+        for (auto at = json.find("\"OnFrameUpdate\""); at != std::string::npos; at = json.find("\"OnFrameUpdate\"", at + 1)) frames++;
+        const auto firstTid = json.find("\"tid\":");
+        const auto tid = firstTid == std::string::npos ? std::string() : json.substr(firstTid, json.find(',', firstTid) - firstTid);
+        const bool twoThreads = !tid.empty() && json.find("\"tid\":", firstTid + 1) != std::string::npos &&
+                                json.find(tid) != json.rfind(tid) && json.find("SetVelocity") != std::string::npos;
+
+        const bool ok = tracer.Dropped() == 0 && events == tracer.Written() && frames == kFrames && twoThreads &&
+                        json.ends_with("]}\n");
+        std::printf("EventTrace  %s  %zu events (%zu frames + physics thread), %llu dropped, %.0f ns per traced frame (4 spans)\n",
+                    ok ? "ok" : "FAILED", events, frames, (unsigned long long)tracer.Dropped(), frameNs);
+        std::filesystem::remove(path);
+        return ok;
+    }
+
+    // Frame trace resets: a session whose live solver is started over mid-climb (a load) replays
+    // cleanly when the writer records the reset, and diverges when it does not.
+    Climb::ReplayStats RecordWithReload(const char* path, bool writeReset) {
+        const auto frames = Synthetic::MakeSession({});
+        const ClimbingSettings settings;
+        Climb::ClimbSolver solver;
+        Climb::TraceWriter writer;
+        if (!writer.Open(path)) return {};
+        bool reloaded = false;
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            if (!reloaded && i >= frames.size() / 2 && solver.IsClimbing()) {
+                solver.Reset();
+                if (writeReset) writer.Reset(Climb::TraceResetReason::kLoad);
+                reloaded = true;
+            }
+            const auto& in = frames[i];
+            Climb::Vec3 relPos[2] = {in.hands[Climb::kLeft].position, in.hands[Climb::kRight].position};
+            writer.Write(in, solver.Step(in, settings), relPos, settings);
+        }
+        writer.Close();
+        Climb::TraceReader trace;
+        if (!reloaded || !trace.Open(path)) return {};
+        return Climb::Replay(trace, 1e-3f);
+    }
+
+    bool CheckFrameTrace() {
+        const auto path = (std::filesystem::temp_directory_path() / "ClimbTests_Trace.bin").string();
+        const auto marked = RecordWithReload(path.c_str(), true);
+        const auto unmarked = RecordWithReload(path.c_str(), false);
+        std::filesystem::remove(path);
+
+        const bool ok = marked.frames > 0 && marked.resets == 2 && marked.mismatches == 0 && unmarked.resets == 1 &&
+                        unmarked.mismatches > 0;
+        std::printf("FrameTrace  %s  reload mid-climb: %zu frames, %zu resets, %zu mismatches (%zu without the reset record)\n",
+                    ok ? "ok" : "FAILED", marked.frames, marked.resets, marked.mismatches, unmarked.mismatches);
+        return ok;
+    }
+
+    // Log rate limiter: an every-frame message (ice slip) for 10 s at 90 Hz with a 2 s interval logs
+    // 5 lines whose repeat counts add up to the rest; 4 threads racing at one instant let exactly one through.
+    bool CheckLogLimiter() {
+        constexpr std::int64_t kFrameNs = 1000000000 / 90;
+        constexpr std::int64_t kInterval = 2000000000;
+        constexpr int kFrames = 900;
+        Climb::LogRateLimiter limiter;
+        int logged = 0;
+        std::uint64_t repeatsReported = 0;
+        for (int f = 0; f < kFrames; f++) {
+            std::uint32_t repeats = 0;
+            if (limiter.Allow(f * kFrameNs, kInterval, repeats)) {
+                logged++;
+                repeatsReported += repeats;
+            }
+        }
+        std::uint32_t tail = 0;
+        limiter.Allow(std::int64_t{1} << 40, kInterval, tail);  // Next line after the burst carries the remainder
+        bool ok = logged == 5 && repeatsReported + tail + logged == kFrames;
+
+        Climb::LogRateLimiter race;
+        std::atomic<int> allowed{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 100000; i++) {
+                    std::uint32_t repeats;
+                    if (race.Allow(1000, kInterval, repeats)) allowed++;
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        ok &= allowed == 1;
+
+        constexpr int kCalls = 1000000;
+        const auto t0 = std::chrono::steady_clock::now();
+        int sink = 0;
+        for (int i = 0; i < kCalls; i++) {
+            std::uint32_t repeats;
+            sink += limiter.Allow(Climb::LogRateLimiter::NowNs(), kInterval, repeats);
+        }
+        const double callNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / kCalls;
+        std::printf("LogRateLimiter  %s  900 ice-slip frames -> %d lines (%llu + %u repeats reported), %.1f ns per "
+                    "suppressed call (sink %d)\n",
+                    ok ? "ok" : "FAILED", logged, (unsigned long long)repeatsReported, tail, callNs, sink);
+        return ok;
+    }
+
+    // First ray of `hand` that reaches the wall plane x = wallX within its grab distance; -1 = none
+    int WallHit(const Climb::RayBatch& batch, int hand, float wallX) {
+        for (int i = 0; i < batch.count[hand]; i++) {
+            const int n = batch.first[hand] + i;
+            const float fromX = batch.from[n][0] / Climb::kHavokScale, toX = batch.to[n][0] / Climb::kHavokScale;
+            if (fromX >= wallX || toX < wallX) continue;
+            if ((wallX - fromX) / (toX - fromX) * batch.length[n] <= batch.grabDist[n]) return n;
+        }
+        return -1;
+    }
+
+    // Grab look-ahead: a hand lunging at a wall grabs earlier by about the look-ahead, while a hand
+    // moving past a wall out of reach and a nearly still hand get no extra grab (or ray).
+    bool CheckGrabPrediction() {
+        const ClimbingSettings settings;
+        const float hz = 90.0f, wallX = 200.0f;
+        const Climb::ProbeMode modes[2] = {Climb::ProbeMode::kFan, Climb::ProbeMode::kNone};
+        Climb::RayBatch batch;
+
+        // Frame at which a palm-forward hand moving at `velocity` first reaches the wall
+        auto firstGrab = [&](Climb::Vec3 velocity, float lookAheadMs, bool& predicted, int& rays) {
+            Climb::HandRayPose poses[2];
+            poses[0] = {{0.0f, 0.0f, 100.0f}, {0, -1, 0}, {1, 0, 0}, {0, 0, 1}, velocity * (lookAheadMs * 0.001f)};
+            for (int f = 0; f < 90; f++) {
+                Climb::BuildRayBatch(poses, modes, settings.fRayDist, settings.iRayFanSize, batch);
+                rays = batch.count[0];
+                if (const int n = WallHit(batch, 0, wallX); n >= 0) {
+                    predicted = batch.predicted[n];
+                    return f;
+                }
+                poses[0].translate += velocity / hz;
+            }
+            return -1;
+        };
+
+        bool predicted = false;
+        int rays = 0, fanRays = 0;
+        const Climb::Vec3 lunge{600.0f, 0.0f, 150.0f};
+        const int late = firstGrab(lunge, 0.0f, predicted, fanRays);
+        const int early = firstGrab(lunge, settings.fGrabLookAhead, predicted, rays);
+        const int gained = late - early;
+        // About lookAhead * 90 Hz frames (3.6 at 40 ms), give or take the frame the plane falls in
+        const float expected = settings.fGrabLookAhead * 0.001f * hz;
+        bool ok = late > 0 && early >= 0 && predicted && rays == fanRays + 1 && gained >= expected - 1.0f &&
+                  gained <= expected + 1.0f;
+
+        bool passPredicted = false;
+        const int pass = firstGrab({0.0f, 0.0f, 600.0f}, 200.0f, passPredicted, rays);  // Climbing past, wall out of reach
+        ok &= pass < 0;
+
+        bool slowPredicted = false;
+        firstGrab({20.0f, 0.0f, 0.0f}, settings.fGrabLookAhead, slowPredicted, rays);  // 0.8 units of travel
+        ok &= rays == fanRays;
+
+        std::printf("Grab look-ahead  %s  600 u/s lunge grabs %d frames (%.0f ms) earlier at %.0f ms look-ahead; "
+                    "passing and slow hands add no grab\n",
+                    ok ? "ok" : "FAILED", gained, gained * 1000.0f / hz, settings.fGrabLookAhead);
+        return ok;
+    }
+
+    // Grab anchor at the grip timestamp: a reaching hand on a moving player, grips pressed at random
+    // times between frames. The frame-quantized anchor is the pose on the frame that sees the press
+    // (one frame later again with a frame of input latency); the rewound anchor interpolates the
+    // hand and player histories at the press time. Errors are against the true pose at the press.
+    bool CheckGripAnchor() {
+        auto body = [](double t) { return Climb::Vec3(static_cast<float>(50.0 * t), 0.0f, static_cast<float>(-200.0 * t)); };
+        auto hand = [](double t) {  // Relative to the player; up to ~380 units/s
+            return Climb::Vec3(0.0f, static_cast<float>(35.0 + 40.0 * std::sin(9.42 * t)), static_cast<float>(90.0 + 30.0 * std::sin(6.91 * t)));
+        };
+        constexpr double kClockBase = 12345.0;  // Seconds of uptime, as the steady clock would read
+        bool ok = true;
+        for (double hz : {72.0, 90.0}) {
+            for (int latency = 0; latency <= 1; latency++) {
+                std::uint32_t seed = 99;
+                double quantErr = 0.0, rewindErr = 0.0, quantMax = 0.0, rewindMax = 0.0;
+                constexpr int kPresses = 200;
+                for (int p = 0; p < kPresses; p++) {
+                    seed = seed * 1664525u + 1013904223u;
+                    const double press = 0.5 + (seed >> 8) / 16777216.0 * 3.0;
+                    const auto pressNs = static_cast<std::int64_t>((kClockBase + press) * 1e9);
+                    const int seenFrame = static_cast<int>(std::ceil(press * hz)) + latency;
+
+                    Climb::KinematicsRing handRing, bodyRing;
+                    for (int f = seenFrame - 40; f <= seenFrame; f++) {
+                        handRing.Push(hand(f / hz), kClockBase + f / hz);
+                        bodyRing.Push(body(f / hz), kClockBase + f / hz);
+                    }
+                    const Climb::Vec3 truth = hand(press) + body(press);
+                    const Climb::Vec3 current = hand(seenFrame / hz) + body(seenFrame / hz);
+                    const Climb::Vec3 rewound = Climb::PositionAtTime(current, handRing, bodyRing, pressNs * 1e-9, 0.1);
+                    const double q = current.GetDistance(truth), r = rewound.GetDistance(truth);
+                    quantErr += q;
+                    rewindErr += r;
+                    quantMax = std::max(quantMax, q);
+                    rewindMax = std::max(rewindMax, r);
+                }
+                quantErr /= kPresses;
+                rewindErr /= kPresses;
+                ok &= rewindErr < quantErr * 0.1 && rewindMax < quantMax;
+                std::printf("Grip anchor  %s  %.0f Hz, %d frame latency: error %.2f mean / %.2f max units frame-quantized, "
+                            "%.3f / %.3f rewound\n",
+                            ok ? "ok" : "FAILED", hz, latency, quantErr, quantMax, rewindErr, rewindMax);
+            }
+        }
+
+        // A press older than the rewind limit keeps the current pose
+        Climb::KinematicsRing handRing, bodyRing;
+        for (int f = 0; f < 60; f++) {
+            handRing.Push(hand(f / 90.0), f / 90.0);
+            bodyRing.Push(body(f / 90.0), f / 90.0);
+        }
+        const Climb::Vec3 current{1.0f, 2.0f, 3.0f};
+        const Climb::Vec3 old = Climb::PositionAtTime(current, handRing, bodyRing, 59 / 90.0 - 0.3, 0.1);
+        const Climb::Vec3 future = Climb::PositionAtTime(current, handRing, bodyRing, 60 / 90.0, 0.1);
+        ok &= old.x == current.x && old.y == current.y && old.z == current.z && future.z == current.z;
+        return ok;
+    }
+
+    // Distance in representable floats (0 = identical bits)
+    std::uint32_t UlpDiff(float a, float b) {
+        std::int32_t ia, ib;
+        std::memcpy(&ia, &a, 4);
+        std::memcpy(&ib, &b, 4);
+        if (ia < 0) ia = std::int32_t(0x80000000u - std::uint32_t(ia));
+        if (ib < 0) ib = std::int32_t(0x80000000u - std::uint32_t(ib));
+        return ia > ib ? std::uint32_t(ia) - std::uint32_t(ib) : std::uint32_t(ib) - std::uint32_t(ia);
+    }
+
+    std::uint32_t UlpDiff(const Climb::Vec4& a, const Climb::Vec3& b) {
+        return std::max({UlpDiff(a.X(), b.x), UlpDiff(a.Y(), b.y), UlpDiff(a.Z(), b.z)});
+    }
+
+    // Vec4 must reproduce the scalar Vec3 math: per operation on random vectors, and through the
+    // whole velocity pipeline over the synthetic session. Allows 1 ulp for compilers that fuse
+    // the scalar multiply-adds; the SSE and fallback builds here match exactly.
+    bool CheckVec4() {
+        constexpr std::uint32_t kMaxUlp = 1;
+        std::uint32_t seed = 777;
+        auto rnd = [&seed] {
+            seed = seed * 1664525u + 1013904223u;
+            return ((seed >> 8) / 16777216.0f - 0.5f) * 2000.0f;
+        };
+        std::uint32_t opUlp = 0;
+        for (int i = 0; i < 100000; i++) {
+            const Climb::Vec3 a(rnd(), rnd(), rnd()), b(rnd(), rnd(), rnd());
+            const Climb::Vec4 va(a), vb(b);
+            const float s = rnd() / 1000.0f;
+            opUlp = std::max({opUlp, UlpDiff(va + vb, a + b), UlpDiff(va - vb, a - b), UlpDiff(va * s, a * s),
+                              UlpDiff(va.Length(), a.Length()), UlpDiff(va.SqrLength(), a.SqrLength()),
+                              UlpDiff(ClampLength(va, 700.0f), Climb::ClampLength(a, 700.0f)),
+                              UlpDiff(Synthetic::BoostZ(va, s), Synthetic::BoostZ(a, s))});
+        }
+
+        const auto frames = Synthetic::MakeSession({});
+        const ClimbingSettings settings;
+        Synthetic::VelocityPipeline<Climb::Vec3> scalar;
+        Synthetic::VelocityPipeline<Climb::Vec4> simd;
+        std::uint32_t pipeUlp = 0;
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            if (i % 120 == 0) {  // New grab every cycle, entering at fall speed
+                scalar.Start(Climb::Vec3(0.0f, 0.0f, -600.0f), settings);
+                simd.Start(Climb::Vec4(0.0f, 0.0f, -600.0f), settings);
+            }
+            const Climb::Vec3 hands[2] = {frames[i].hands[Climb::kLeft].velocity, frames[i].hands[Climb::kRight].velocity};
+            pipeUlp = std::max(pipeUlp, UlpDiff(simd.Step(hands, frames[i].dt, settings), scalar.Step(hands, frames[i].dt, settings)));
+        }
+
+        float sink = 0.0f;
+        const int n = static_cast<int>(frames.size());
+        auto time = [&](auto& pipeline) {
+            return Bench::NsPer(n * 20, [&](int i) {
+                const auto& f = frames[i % n];
+                const Climb::Vec3 hands[2] = {f.hands[Climb::kLeft].velocity, f.hands[Climb::kRight].velocity};
+                sink += Synthetic::GetZ(pipeline.Step(hands, f.dt, settings));
+            });
+        };
+        const double scalarNs = time(scalar);
+        const double simdNs = time(simd);
+
+        const bool ok = opUlp <= kMaxUlp && pipeUlp <= kMaxUlp;
+        std::printf("Vec4 (%s)  %s  max %u ulp per op, %u ulp through the velocity pipeline; pipeline %.2f ns scalar, "
+                    "%.2f ns Vec4 (sink %.1f)\n",
+#ifdef FREECLIMB_SSE
+                    "SSE",
+#else
+                    "scalar fallback",
+#endif
+                    ok ? "ok" : "FAILED", opUlp, pipeUlp, scalarNs, simdNs, sink);
+        return ok;
+    }
+
+    // Fake controller address for `slot`; `gen` gives the slot a new controller (3D reload).
+    // The slot can be read back from the address, so a reader can tell a right answer from a wrong one.
+    std::uintptr_t ControllerAddress(int slot, std::uint32_t gen) {
+        return 0x7FF612340000ull + (std::uintptr_t{gen} << 16) + static_cast<std::uintptr_t>(slot) * 0x2A0;
+    }
+    int SlotOf(std::uintptr_t address) { return static_cast<int>(((address - 0x7FF612340000ull) & 0xFFFF) / 0x2A0); }
+
+    // Controller -> climber lookup: hits, misses, erasure and tombstone reuse, the rebuild that
+    // clears tombstones, and a reader thread hammering Find while the frame thread rebinds half
+    // the slots to new controllers. A reader may miss a slot mid-rebind but never gets a wrong one,
+    // and the slots that are never rebound are always found.
+    bool CheckControllerMap() {
+        constexpr int kSlots = Climb::ClimberPool<int>::kMaxClimbers;
+        Climb::ControllerMap map;
+        bool ok = true;
+        for (int slot = 0; slot < kSlots; slot++) ok &= map.Insert(ControllerAddress(slot, 0), slot);
+        for (int slot = 0; slot < kSlots; slot++) ok &= map.Find(ControllerAddress(slot, 0)) == slot;
+        int falseHits = 0;
+        for (std::uint32_t npc = 1; npc <= 1000; npc++) falseHits += map.Find(ControllerAddress(0, npc)) >= 0;
+        ok &= falseHits == 0;
+        ok &= !map.Insert(0, 1) && !map.Insert(ControllerAddress(1, 0) | 1, 1);
+
+        map.Erase(ControllerAddress(3, 0));
+        ok &= map.Find(ControllerAddress(3, 0)) == -1 && map.Tombstones() == 1;
+        ok &= map.Insert(ControllerAddress(3, 0), 3) && map.Find(ControllerAddress(3, 0)) == 3 && map.Tombstones() == 0;
+
+        std::uintptr_t bound[kSlots];
+        for (int slot = 0; slot < kSlots; slot++) bound[slot] = ControllerAddress(slot, 0);
+        std::uint32_t maxTombstones = 0;
+        for (std::uint32_t gen = 1; gen <= 2000; gen++) {
+            const int slot = static_cast<int>(gen % kSlots);
+            map.Erase(bound[slot]);
+            maxTombstones = std::max(maxTombstones, map.Tombstones());
+            bound[slot] = ControllerAddress(slot, gen);
+            ok &= map.Insert(bound[slot], slot);
+        }
+        int found = 0;
+        for (int slot = 0; slot < kSlots; slot++) found += map.Find(bound[slot]) == slot;
+        ok &= found == kSlots && maxTombstones <= Climb::ControllerMap::kCapacity / 4;
+
+        // Concurrent: slots 0-7 keep their controller, 8-15 are rebound every step
+        Climb::ControllerMap shared;
+        for (int slot = 0; slot < kSlots; slot++) shared.Insert(ControllerAddress(slot, 0), slot);
+        std::atomic<bool> done{false};
+        std::atomic<std::uint32_t> latestGen{0};
+        std::uint64_t lookups = 0, wrong = 0, stableMisses = 0;
+        std::thread reader([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                const std::uint32_t gen = latestGen.load(std::memory_order_relaxed);
+                for (int slot = 0; slot < kSlots; slot++) {
+                    const auto address = ControllerAddress(slot, slot < kSlots / 2 ? 0 : gen);
+                    const int found = shared.Find(address);
+                    if (found >= 0 && found != SlotOf(address)) wrong++;
+                    if (slot < kSlots / 2 && found != slot) stableMisses++;
+                    lookups++;
+                }
+            }
+        });
+        constexpr std::uint32_t kRebinds = 200000;
+        for (std::uint32_t gen = 1; gen <= kRebinds; gen++) {
+            for (int slot = kSlots / 2; slot < kSlots; slot++) {
+                shared.Erase(ControllerAddress(slot, gen - 1));
+                shared.Insert(ControllerAddress(slot, gen), slot);
+            }
+            latestGen.store(gen, std::memory_order_relaxed);
+        }
+        done = true;
+        reader.join();
+        ok &= wrong == 0 && stableMisses == 0 && lookups > 0;
+
+        std::printf("ControllerMap  %s  %d slots, 1000 non-climbing controllers -> %d hits, at most %u tombstones over "
+                    "2000 rebinds; concurrent: %llu lookups during %u x 8 rebinds, %llu wrong, %llu stable misses\n",
+                    ok ? "ok" : "FAILED", kSlots, falseHits, maxTombstones, (unsigned long long)lookups, kRebinds,
+                    (unsigned long long)wrong, (unsigned long long)stableMisses);
+        return ok;
+    }
+
+    // Command `n` as the frame thread would publish it: every field derived from n, so a reader can
+    // tell a snapshot mixing two commands from a real one.
+    Climb::VelocityCommand NthCommand(std::uint32_t n) {
+        const float f = static_cast<float>(n & 0xFFFFFF);
+        return {Climb::Vec4(f, -f, 2.0f * f), (n & 1) != 0, n, std::int64_t{n} * 11111};
+    }
+    bool IsNthCommand(const Climb::VelocityCommand& cmd) {
+        return cmd.frame >= 0 && cmd.frame <= 0xFFFFFFFF && [&] {
+            const auto want = NthCommand(static_cast<std::uint32_t>(cmd.frame));
+            return cmd.velocity.X() == want.velocity.X() && cmd.velocity.Y() == want.velocity.Y() &&
+                   cmd.velocity.Z() == want.velocity.Z() && cmd.active == want.active && cmd.timeNs == want.timeNs;
+        }();
+    }
+
+    // Frame -> physics velocity handoff: one writer publishing every ~300 ns (far faster than a frame)
+    // while three readers copy commands back to back, as HookSetVelocity does. Every snapshot must be
+    // one whole command and commands never go backwards for a reader. The same fields written one by
+    // one (the old plain PlayerState members) are raced the same way to show the tears the seqlock
+    // removes. Staleness: a command is dropped once older than the limit.
+    bool CheckVelocityCommand() {
+        constexpr int kReaders = 3;
+        constexpr std::uint32_t kWrites = 500000;
+        auto pace = [] {
+            const auto until = std::chrono::steady_clock::now() + std::chrono::nanoseconds(300);
+            while (std::chrono::steady_clock::now() < until) {}
+        };
+        // Runs `read` on kReaders threads for as long as `write` keeps publishing
+        auto race = [&](auto&& write, auto&& read, std::uint64_t& reads, std::uint64_t& bad) {
+            std::atomic<bool> done{false};
+            std::atomic<int> ready{0};
+            std::atomic<std::uint64_t> totalReads{0}, totalBad{0};
+            std::vector<std::thread> readers;
+            for (int r = 0; r < kReaders; r++) {
+                readers.emplace_back([&] {
+                    std::uint64_t n = 0, b = 0;
+                    std::int64_t last = 0;
+                    ready++;
+                    while (!done.load(std::memory_order_relaxed)) {
+                        b += read(last);
+                        n++;
+                    }
+                    totalReads += n;
+                    totalBad += b;
+                });
+            }
+            while (ready < kReaders) {}
+            for (std::uint32_t n = 1; n <= kWrites; n++) {
+                write(NthCommand(n));
+                pace();
+            }
+            done = true;
+            for (auto& t : readers) t.join();
+            reads = totalReads;
+            bad = totalBad;
+        };
+
+        Climb::VelocityCommandSlot slot;
+        std::uint64_t reads = 0, torn = 0;
+        race([&](const Climb::VelocityCommand& cmd) { slot.Publish(cmd); },
+             [&](std::int64_t& last) {
+                 const auto cmd = slot.Read();
+                 const bool bad = (!IsNthCommand(cmd) && cmd.frame != 0) || cmd.frame < last;
+                 last = cmd.frame;
+                 return bad;
+             },
+             reads, torn);
+
+        // Unsynchronized fields (relaxed atomics, so the race is defined behaviour)
+        struct {
+            std::atomic<float> x, y, z;
+            std::atomic<bool> active;
+            std::atomic<std::int64_t> frame, timeNs;
+        } plain{};
+        std::uint64_t plainReads = 0, plainTorn = 0;
+        race([&](const Climb::VelocityCommand& cmd) {
+                 plain.x.store(cmd.velocity.X(), std::memory_order_relaxed);
+                 plain.y.store(cmd.velocity.Y(), std::memory_order_relaxed);
+                 plain.z.store(cmd.velocity.Z(), std::memory_order_relaxed);
+                 plain.active.store(cmd.active, std::memory_order_relaxed);
+                 plain.frame.store(cmd.frame, std::memory_order_relaxed);
+                 plain.timeNs.store(cmd.timeNs, std::memory_order_relaxed);
+             },
+             [&](std::int64_t&) {
+                 Climb::VelocityCommand cmd;
+                 cmd.velocity = Climb::Vec4(plain.x.load(std::memory_order_relaxed), plain.y.load(std::memory_order_relaxed),
+                                            plain.z.load(std::memory_order_relaxed));
+                 cmd.active = plain.active.load(std::memory_order_relaxed);
+                 cmd.frame = plain.frame.load(std::memory_order_relaxed);
+                 cmd.timeNs = plain.timeNs.load(std::memory_order_relaxed);
+                 return !IsNthCommand(cmd) && cmd.frame != 0;
+             },
+             plainReads, plainTorn);
+
+        constexpr std::int64_t kMaxAgeNs = 250000000;
+        Climb::VelocityCommandSlot stale;
+        stale.Publish({Climb::Vec4(0.0f, 0.0f, 300.0f), true, 42, 1000000000});
+        const auto last = stale.Read();
+        bool ok = torn == 0 && reads > kWrites;
+        ok &= last.IsFresh(1000000000 + kMaxAgeNs, kMaxAgeNs) && !last.IsFresh(1000000001 + kMaxAgeNs, kMaxAgeNs);
+        stale.Clear();
+        ok &= !stale.Read().active;
+
+        float sink = 0.0f;
+        const double readNs = Bench::NsPer(1000000, [&](int) { sink += slot.Read().velocity.Z(); });
+        std::printf("VelocityCommand  %s  %u writes vs %d readers: %llu reads, %llu torn or out of order; "
+                    "unsynchronized fields: %llu of %llu reads torn; %.1f ns per uncontended read (sink %.0f)\n",
+                    ok ? "ok" : "FAILED", kWrites, kReaders, (unsigned long long)reads, (unsigned long long)torn,
+                    (unsigned long long)plainTorn, (unsigned long long)plainReads, readNs, sink);
+        return ok;
+    }
+
+    struct Check {
+        const char* name;
+        bool (*run)();
+    };
+
+    constexpr Check kChecks[] = {
+        {"GripEdges", CheckGripEdges},
+        {"RefreshRates", CheckRefreshRates},
+        {"SettingsSchema", CheckSettingsSchema},
+        {"MaterialMatcher", CheckMaterialMatcher},
+        {"VoicePool", CheckVoicePool},
+        {"StageTimer", CheckStageTimer},
+        {"EventTrace", CheckEventTrace},
+        {"FrameTrace", CheckFrameTrace},
+        {"LogLimiter", CheckLogLimiter},
+        {"Vec4", CheckVec4},
+        {"GrabPrediction", CheckGrabPrediction},
+        {"GripAnchor", CheckGripAnchor},
+        {"ControllerMap", CheckControllerMap},
+        {"VelocityCommand", CheckVelocityCommand},
+    };
+}
+
+int main(int argc, char** argv) {
+    bool ok = true;
+    if (argc < 2) {
+        for (const auto& check : kChecks) ok &= check.run();
+        return ok ? 0 : 1;
+    }
+    for (int i = 1; i < argc; i++) {
+        const auto check = std::find_if(std::begin(kChecks), std::end(kChecks),
+                                        [&](const Check& c) { return !std::strcmp(c.name, argv[i]); });
+        if (check == std::end(kChecks)) {
+            std::fprintf(stderr, "Unknown check %s\n", argv[i]);
+            return 2;
+        }
+        ok &= check->run();
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+// Deterministic replay of a recorded FrameTrace through the headless ClimbSolver.
+// Usage: ClimbReplay <trace> [--repeat N] [--tolerance T] [--verbose]
+// Feeds every recorded frame back through the solver (using the recorded settings, and a fresh
+// solver after each reset record), diffs the resulting velocity commands against the recording
+// and reports replay speed.
+// Exit code is 1 when any frame diverges by more than the tolerance.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "FrameTrace.h"
+
+namespace {
+    Climb::ReplayStats Replay(const Climb::TraceReader& trace, float tolerance, bool verbose) {
+        if (!verbose) return Climb::Replay(trace, tolerance);
+        return Climb::Replay(trace, tolerance, [](const Climb::TraceRecord& rec, const Climb::FrameCommand& cmd) {
+            const auto& f = rec.frameData;
+            std::printf("frame %u: set %d/%d launch %d/%d velo (%.3f %.3f %.3f) vs (%.3f %.3f %.3f)\n", rec.frame,
+                        cmd.setVelocity, (f.flags & Climb::kTraceSetVelocity) != 0, cmd.launch,
+                        (f.flags & Climb::kTraceLaunch) != 0, cmd.velocity.X(), cmd.velocity.Y(), cmd.velocity.Z(),
+                        f.outVelocity[0], f.outVelocity[1], f.outVelocity[2]);
+        });
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <trace> [--repeat N] [--tolerance T] [--verbose]\n", argv[0]);
+        return 2;
+    }
+
+    int repeats = 1;
+    float tolerance = 1e-3f;
+    bool verbose = false;
+    for (int i = 2; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) repeats = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--tolerance") && i + 1 < argc) tolerance = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--verbose")) verbose = true;
+    }
+    if (repeats < 1) repeats = 1;
+
+    Climb::TraceReader trace;
+    if (!trace.Open(argv[1])) {
+        std::fprintf(stderr, "Failed to open trace %s (missing or incompatible version)\n", argv[1]);
+        return 2;
+    }
+
+    Climb::ReplayStats stats = Replay(trace, tolerance, verbose);
+
+    // Timing passes (diffing included, verbose output excluded)
+    double recordedSeconds = 0.0;
+    for (std::size_t i = 0; i < trace.Count(); i++) {
+        if (trace[i].kind == Climb::TraceKind::kFrame) recordedSeconds += trace[i].frameData.dt;
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) Replay(trace, tolerance, false);
+    auto end = std::chrono::steady_clock::now();
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    double perFrame = stats.frames ? ns / (static_cast<double>(stats.frames) * repeats) : 0.0;
+
+    std::printf("frames=%zu  resets=%zu  recorded=%.2fs  mismatches=%zu  maxDiff=%.6f  %.2f ns/frame  (%.0fx real time)\n",
+                stats.frames, stats.resets, recordedSeconds, stats.mismatches, stats.maxDiff, perFrame,
+                ns > 0.0 ? recordedSeconds * 1e9 * repeats / ns : 0.0);
+    if (stats.mismatches) {
+        std::printf("first mismatch at frame %zu\n", stats.firstMismatch);
+        return 1;
+    }
+    return 0;
+}